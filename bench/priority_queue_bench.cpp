@@ -0,0 +1,80 @@
+
+#include "runque.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using item_type = std::shared_ptr<std::uint64_t>;
+
+struct item_less {
+  inline bool operator()(item_type const& left,
+                         item_type const& right) const noexcept {
+    return *left < *right;
+  }
+};
+
+struct item_key {
+  inline std::uint64_t operator()(item_type const& item) const noexcept {
+    return *item;
+  }
+};
+
+constexpr std::size_t item_count = 500000;
+
+template<typename Queue>
+double measure(std::vector<item_type> const& items) {
+  Queue queue{};
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto& item : items) {
+    queue.push(item_type{item});
+  }
+
+  std::uint64_t previous{~std::uint64_t{}};
+  while (!queue.empty()) {
+    auto item = queue.pop();
+    if (previous < *item) {
+      std::cerr << "order violated\n";
+    }
+
+    previous = *item;
+  }
+
+  std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                        start};
+  return static_cast<double>(items.size()) / elapsed.count();
+}
+
+void report(char const* name, double rate) {
+  std::cout << std::setw(16) << std::left << name << std::setw(12)
+            << std::right << static_cast<std::uint64_t>(rate)
+            << " items/s\n";
+}
+
+int main() {
+  std::mt19937_64 rng{42};
+
+  std::vector<item_type> items{};
+  items.reserve(item_count);
+
+  for (std::size_t i = 0; i < item_count; ++i) {
+    items.push_back(std::make_shared<std::uint64_t>(rng()));
+  }
+
+  report(
+      "binary heap",
+      measure<frq::priority_runque_queue<item_type,
+                                         std::allocator<item_type>,
+                                         item_less>>(items));
+
+  report("keyed 4-ary heap",
+         measure<frq::keyed_priority_runque_queue<item_type, item_key>>(
+             items));
+
+  return 0;
+}
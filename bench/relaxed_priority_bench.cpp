@@ -0,0 +1,174 @@
+
+#include "runque.hpp"
+#include "sync_wait.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using strict_runque =
+    frq::runque<frq::priority_runque_queue<std::uint64_t>,
+                frq::coro_thread_model>;
+
+using relaxed_runque =
+    frq::runque<frq::relaxed_priority_runque_queue<std::uint64_t>,
+                frq::coro_thread_model>;
+
+constexpr std::size_t item_count = 200000;
+constexpr std::size_t quality_count = 100000;
+
+template<typename Runque>
+double measure_throughput(std::size_t threads) {
+  Runque runque{};
+
+  auto per_thread = item_count / threads;
+
+  std::atomic<std::uint64_t> checksum{0};
+  std::vector<std::thread> workers{};
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&runque, &checksum, i, per_thread] {
+      std::mt19937_64 rng{i};
+
+      std::uint64_t sum{0};
+      for (std::size_t j = 0; j < per_thread; ++j) {
+        frq::sync_wait(runque.put(rng() % item_count));
+        sum += frq::sync_wait(runque.get());
+      }
+
+      checksum += sum;
+    });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                        start};
+
+  if (checksum.load() == 0) {
+    std::cerr << "empty checksum\n";
+  }
+
+  return static_cast<double>(per_thread * threads) / elapsed.count();
+}
+
+class rank_counter {
+public:
+  explicit inline rank_counter(std::size_t size)
+      : tree_(size + 1, 0) {
+  }
+
+  inline void add(std::size_t index, std::int64_t delta) noexcept {
+    for (++index; index < tree_.size(); index += index & (~index + 1)) {
+      tree_[index] += delta;
+    }
+  }
+
+  inline std::int64_t below(std::size_t index) const noexcept {
+    std::int64_t result{0};
+    for (; index != 0; index -= index & (~index + 1)) {
+      result += tree_[index];
+    }
+
+    return result;
+  }
+
+  inline std::int64_t total() const noexcept {
+    return below(tree_.size() - 1);
+  }
+
+private:
+  std::vector<std::int64_t> tree_;
+};
+
+template<typename Runque>
+void measure_quality(char const* name, std::size_t threads) {
+  Runque runque{};
+
+  std::mt19937_64 rng{42};
+  std::vector<std::uint64_t> items(quality_count);
+  for (std::size_t i = 0; i < quality_count; ++i) {
+    items[i] = i;
+  }
+
+  std::shuffle(items.begin(), items.end(), rng);
+
+  for (auto item : items) {
+    frq::sync_wait(runque.put(std::uint64_t{item}));
+  }
+
+  std::vector<std::vector<std::uint64_t>> taken(threads);
+  std::vector<std::thread> workers{};
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&runque, &taken, i, threads] {
+      for (std::size_t j = 0; j < quality_count / threads; ++j) {
+        taken[i].push_back(frq::sync_wait(runque.get()));
+      }
+    });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  // interleave per-thread sequences to approximate the global pop order
+  std::vector<std::uint64_t> order{};
+  for (std::size_t j = 0; j < quality_count / threads; ++j) {
+    for (std::size_t i = 0; i < threads; ++i) {
+      order.push_back(taken[i][j]);
+    }
+  }
+
+  rank_counter ranks{quality_count};
+  for (std::size_t i = 0; i < quality_count; ++i) {
+    ranks.add(i, 1);
+  }
+
+  std::uint64_t max_error{0};
+  double total_error{0};
+  for (auto item : order) {
+    auto error = static_cast<std::uint64_t>(ranks.total() -
+                                            ranks.below(item + 1));
+    max_error = std::max(max_error, error);
+    total_error += static_cast<double>(error);
+
+    ranks.add(item, -1);
+  }
+
+  std::cout << std::setw(10) << std::left << name << std::setw(4)
+            << std::right << threads << " threads  rank error mean "
+            << std::setw(10) << std::fixed << std::setprecision(2)
+            << total_error / static_cast<double>(order.size()) << "  max "
+            << max_error << '\n';
+}
+
+void report(char const* name, std::size_t threads, double rate) {
+  std::cout << std::setw(10) << std::left << name << std::setw(4)
+            << std::right << threads << " threads  " << std::setw(12)
+            << static_cast<std::uint64_t>(rate) << " items/s\n";
+}
+
+int main() {
+  auto limit = std::max(std::thread::hardware_concurrency(), 1U);
+
+  for (std::size_t threads = 1; threads <= limit; threads *= 2) {
+    report("strict", threads, measure_throughput<strict_runque>(threads));
+    report("relaxed", threads, measure_throughput<relaxed_runque>(threads));
+  }
+
+  for (std::size_t threads = 1; threads <= limit; threads *= 2) {
+    measure_quality<strict_runque>("strict", threads);
+    measure_quality<relaxed_runque>("relaxed", threads);
+  }
+
+  return 0;
+}
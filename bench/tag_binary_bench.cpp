@@ -0,0 +1,126 @@
+
+#include "tag_binary.hpp"
+#include "tag_format.hpp"
+#include "tag_stream.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using tag_type = frq::stag_t<std::int32_t, std::uint32_t, std::string>;
+
+constexpr std::size_t tag_count = 1 << 16;
+constexpr std::size_t round_count = 16;
+
+std::vector<tag_type> generate_tags() {
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<std::int32_t> first{-1000, 1000};
+  std::uniform_int_distribution<std::uint32_t> second{0, 1U << 20U};
+  std::uniform_int_distribution<int> letter{'a', 'z'};
+
+  std::vector<tag_type> tags{};
+  tags.reserve(tag_count);
+
+  for (std::size_t i = 0; i < tag_count; ++i) {
+    std::string name(8, ' ');
+    for (auto& c : name) {
+      c = static_cast<char>(letter(rng));
+    }
+
+    tags.emplace_back(
+        frq::construct_tag_default, first(rng), second(rng), std::move(name));
+  }
+
+  return tags;
+}
+
+template<typename Fn>
+double measure(Fn&& fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < round_count; ++i) {
+    fn();
+  }
+
+  std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                        start};
+  return static_cast<double>(tag_count * round_count) / elapsed.count();
+}
+
+void report(char const* name, double rate, std::size_t bytes) {
+  std::cout << std::setw(16) << std::left << name << std::setw(12)
+            << std::right << static_cast<std::uint64_t>(rate) << " tags/s "
+            << std::setw(10) << bytes << " bytes\n";
+}
+
+int main() {
+  auto tags = generate_tags();
+
+  std::vector<std::string> binary(tag_count);
+  std::vector<std::string> text(tag_count);
+
+  std::size_t binary_size{0};
+  auto binary_encode = measure([&] {
+    binary_size = 0;
+    std::array<char, 64> buffer{};
+    for (std::size_t i = 0; i < tag_count; ++i) {
+      auto [ptr, ec] = frq::tag_to_bytes(
+          buffer.data(), buffer.data() + buffer.size(), tags[i]);
+      binary[i].assign(buffer.data(), ptr);
+      binary_size += binary[i].size();
+    }
+  });
+
+  std::size_t text_size{0};
+  auto text_encode = measure([&] {
+    text_size = 0;
+    for (std::size_t i = 0; i < tag_count; ++i) {
+      std::ostringstream stream{};
+      stream << tags[i];
+      text[i] = std::move(stream).str();
+      text_size += text[i].size();
+    }
+  });
+
+  std::size_t failed{0};
+  tag_type result{frq::construct_tag_default, 0, 0U, ""};
+
+  auto binary_decode = measure([&] {
+    for (auto& bytes : binary) {
+      auto [ptr, ec] = frq::tag_from_bytes(
+          bytes.data(), bytes.data() + bytes.size(), result);
+      failed += ec != std::errc{} ? 1 : 0;
+    }
+  });
+
+  auto text_decode = measure([&] {
+    for (auto& chars : text) {
+      auto [ptr, ec] = frq::tag_from_chars(
+          chars.data(), chars.data() + chars.size(), result);
+      failed += ec != std::errc{} ? 1 : 0;
+    }
+  });
+
+  std::uint64_t checksum{0};
+  auto fingerprint = measure([&] {
+    for (auto& tag : tags) {
+      checksum += frq::tag_fingerprint(tag, 2);
+    }
+  });
+
+  report("binary encode", binary_encode, binary_size);
+  report("stream encode", text_encode, text_size);
+  report("binary decode", binary_decode, binary_size);
+  report("text decode", text_decode, text_size);
+  report("fingerprint", fingerprint, 0);
+
+  std::cout << "failed: " << failed << " checksum: " << std::hex << checksum
+            << '\n';
+
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+
+#include "runque.hpp"
+#include "sync_wait.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+using locked_runque =
+    frq::runque<frq::fifo_runque_queue<std::int64_t>, frq::coro_thread_model>;
+
+using mpmc_runque =
+    frq::runque<frq::mpmc_runque_queue<std::int64_t>, frq::coro_thread_model>;
+
+constexpr std::size_t burst_count = 2000;
+constexpr std::size_t burst_size = 16;
+constexpr auto burst_pause = std::chrono::microseconds{50};
+
+inline std::int64_t now_ns() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             clock_type::now().time_since_epoch())
+      .count();
+}
+
+struct result {
+  double rate_;
+  double latency_;
+};
+
+template<typename Runque>
+result measure(std::size_t consumers,
+               frq::wake_order order,
+               std::uint32_t spin) {
+  Runque runque{};
+  runque.set_wake_order(order);
+  runque.set_spin_limit(spin);
+
+  std::atomic<std::int64_t> latency{0};
+  std::atomic<std::size_t> taken{0};
+
+  std::vector<std::thread> workers{};
+  for (std::size_t i = 0; i < consumers; ++i) {
+    workers.emplace_back([&runque, &latency, &taken] {
+      std::int64_t total{0};
+
+      try {
+        for (;;) {
+          auto stamp = frq::sync_wait(runque.get());
+          total += now_ns() - stamp;
+          taken.fetch_add(1, std::memory_order_release);
+        }
+      }
+      catch (frq::interrupted const&) {
+      }
+
+      latency += total;
+    });
+  }
+
+  auto start = clock_type::now();
+  for (std::size_t i = 0; i < burst_count; ++i) {
+    for (std::size_t j = 0; j < burst_size; ++j) {
+      frq::sync_wait(runque.put(now_ns()));
+    }
+
+    std::this_thread::sleep_for(burst_pause);
+  }
+
+  while (taken.load(std::memory_order_acquire) < burst_count * burst_size) {
+    std::this_thread::yield();
+  }
+
+  frq::sync_wait(runque.interrupt());
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  std::chrono::duration<double> elapsed{clock_type::now() - start};
+
+  auto count = static_cast<double>(std::max<std::size_t>(taken.load(), 1));
+  return {count / elapsed.count(),
+          static_cast<double>(latency.load()) / count / 1000.0};
+}
+
+template<typename Runque>
+void report(char const* name, std::size_t consumers) {
+  for (auto order : {frq::wake_order::lifo, frq::wake_order::fifo}) {
+    for (std::uint32_t spin : {0U, 1024U}) {
+      auto [rate, latency] = measure<Runque>(consumers, order, spin);
+
+      std::cout << std::setw(10) << std::left << name << std::setw(3)
+                << std::right << consumers << " consumers  "
+                << (order == frq::wake_order::lifo ? "lifo" : "fifo")
+                << "  spin " << std::setw(5) << spin << std::setw(12)
+                << static_cast<std::uint64_t>(rate) << " items/s  latency "
+                << std::fixed << std::setprecision(2) << latency << " us\n";
+    }
+  }
+}
+
+int main() {
+  auto limit = std::max(std::thread::hardware_concurrency(), 4U);
+
+  for (std::size_t consumers = 1; consumers <= limit; consumers *= 2) {
+    report<locked_runque>("locked", consumers);
+    report<mpmc_runque>("mpmc", consumers);
+  }
+
+  return 0;
+}
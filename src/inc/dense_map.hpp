@@ -0,0 +1,234 @@
+#pragma once
+
+#include "tag.hpp"
+#include "utility.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace frq {
+namespace detail {
+  template<bounded_tag_key Key,
+           typename Value,
+           typename Alloc = std::allocator<std::pair<const Key, Value>>>
+  class dense_map {
+  public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using size_type = std::size_t;
+    using domain_type = tag_domain<key_type>;
+    using allocator_type = rebind_alloc_t<Alloc, value_type>;
+
+    static constexpr size_type size_v = domain_type::size_v;
+
+  private:
+    using node_alloc_traits = std::allocator_traits<allocator_type>;
+
+    using slot_allocator_type = rebind_alloc_t<Alloc, value_type*>;
+    using slot_alloc_traits = std::allocator_traits<slot_allocator_type>;
+
+  public:
+    class iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = dense_map::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = value_type*;
+      using reference = value_type&;
+
+    public:
+      inline iterator() noexcept = default;
+
+      inline iterator(value_type** slots, size_type index) noexcept
+          : slots_{slots}
+          , index_{index} {
+        skip();
+      }
+
+      inline reference operator*() const noexcept {
+        return *slots_[index_];
+      }
+
+      inline pointer operator->() const noexcept {
+        return slots_[index_];
+      }
+
+      inline iterator& operator++() noexcept {
+        ++index_;
+        skip();
+        return *this;
+      }
+
+      inline iterator operator++(int) noexcept {
+        auto old{*this};
+        ++*this;
+        return old;
+      }
+
+      inline bool operator==(iterator const& rhs) const noexcept {
+        return index_ == rhs.index_;
+      }
+
+      inline size_type index() const noexcept {
+        return index_;
+      }
+
+    private:
+      inline void skip() noexcept {
+        if (slots_ == nullptr) {
+          index_ = size_v;
+          return;
+        }
+
+        while (index_ < size_v && slots_[index_] == nullptr) {
+          ++index_;
+        }
+      }
+
+    private:
+      value_type** slots_{nullptr};
+      size_type index_{size_v};
+    };
+
+  public:
+    inline dense_map() noexcept = default;
+
+    explicit inline dense_map(allocator_type const& alloc) noexcept
+        : alloc_{alloc} {
+    }
+
+    inline dense_map(dense_map&& other) noexcept
+        : alloc_{other.alloc_}
+        , slots_{std::exchange(other.slots_, nullptr)}
+        , count_{std::exchange(other.count_, 0)} {
+    }
+
+    dense_map(dense_map const&) = delete;
+
+    dense_map& operator=(dense_map&&) = delete;
+    dense_map& operator=(dense_map const&) = delete;
+
+    inline ~dense_map() {
+      clear();
+
+      if (slots_ != nullptr) {
+        slot_allocator_type alloc{alloc_};
+        slot_alloc_traits::deallocate(alloc, slots_, size_v);
+      }
+    }
+
+    inline iterator begin() noexcept {
+      return iterator{slots_, 0};
+    }
+
+    inline iterator end() noexcept {
+      return iterator{};
+    }
+
+    inline iterator find(key_type const& key) noexcept {
+      auto index = get_index(key);
+      if (index >= size_v || slots_ == nullptr || slots_[index] == nullptr) {
+        return end();
+      }
+
+      return iterator{slots_, index};
+    }
+
+    template<typename... Tys, typename... Txs>
+    std::pair<iterator, bool> emplace(std::piecewise_construct_t /*unused*/,
+                                      std::tuple<Tys...> key_args,
+                                      std::tuple<Txs...> value_args) {
+      auto& key = std::get<0>(key_args);
+      auto index = get_index(key);
+      if (index >= size_v) {
+        throw std::out_of_range{"key outside of bounded tag domain"};
+      }
+
+      ensure_slots();
+      if (slots_[index] != nullptr) {
+        return {iterator{slots_, index}, false};
+      }
+
+      auto node = node_alloc_traits::allocate(alloc_, 1);
+      try {
+        node_alloc_traits::construct(alloc_,
+                                     node,
+                                     std::piecewise_construct,
+                                     std::move(key_args),
+                                     std::move(value_args));
+      }
+      catch (...) {
+        node_alloc_traits::deallocate(alloc_, node, 1);
+        throw;
+      }
+
+      slots_[index] = node;
+      ++count_;
+
+      return {iterator{slots_, index}, true};
+    }
+
+    inline iterator erase(iterator pos) {
+      auto index = pos.index();
+      assert(slots_ != nullptr && slots_[index] != nullptr);
+
+      destroy(std::exchange(slots_[index], nullptr));
+      --count_;
+
+      return iterator{slots_, index + 1};
+    }
+
+    inline bool empty() const noexcept {
+      return count_ == 0;
+    }
+
+    inline size_type size() const noexcept {
+      return count_;
+    }
+
+    inline allocator_type get_allocator() const noexcept {
+      return alloc_;
+    }
+
+  private:
+    // negative keys wrap to large indices, so a single bound rejects both
+    static inline size_type get_index(key_type const& key) noexcept {
+      return static_cast<size_type>(domain_type::index(key));
+    }
+
+    inline void ensure_slots() {
+      if (slots_ == nullptr) {
+        slot_allocator_type alloc{alloc_};
+        slots_ = slot_alloc_traits::allocate(alloc, size_v);
+        std::uninitialized_fill_n(slots_, size_v, nullptr);
+      }
+    }
+
+    inline void clear() noexcept {
+      for (size_type i = 0; count_ != 0 && i < size_v; ++i) {
+        if (slots_[i] != nullptr) {
+          destroy(std::exchange(slots_[i], nullptr));
+          --count_;
+        }
+      }
+    }
+
+    inline void destroy(value_type* node) noexcept {
+      node_alloc_traits::destroy(alloc_, node);
+      node_alloc_traits::deallocate(alloc_, node, 1);
+    }
+
+  private:
+    [[no_unique_address]] allocator_type alloc_{};
+
+    value_type** slots_{nullptr};
+    size_type count_{0};
+  };
+} // namespace detail
+} // namespace frq
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace frq {
+
+template<typename Ty>
+concept executor = requires(Ty& exec, std::coroutine_handle<> handle) {
+  exec.post(handle);
+};
+
+struct inline_executor {
+  inline void post(std::coroutine_handle<> handle) const {
+    handle.resume();
+  }
+};
+
+class executor_ref {
+public:
+  inline executor_ref() noexcept = default;
+
+  template<executor Executor>
+  requires(!std::same_as<Executor, executor_ref>) inline executor_ref(
+      Executor& exec) noexcept
+      : target_{std::addressof(exec)}
+      , post_{[](void* target, std::coroutine_handle<> handle) {
+        static_cast<Executor*>(target)->post(handle);
+      }} {
+  }
+
+  inline void post(std::coroutine_handle<> handle) const {
+    if (post_ == nullptr) {
+      handle.resume();
+    }
+    else {
+      post_(target_, handle);
+    }
+  }
+
+  inline bool is_inline() const noexcept {
+    return post_ == nullptr;
+  }
+
+private:
+  void* target_{nullptr};
+  void (*post_)(void*, std::coroutine_handle<>){nullptr};
+};
+
+class thread_executor {
+public:
+  inline thread_executor()
+      : thread_{[this](std::stop_token stop) { run(stop); }} {
+  }
+
+  thread_executor(thread_executor const&) = delete;
+  thread_executor(thread_executor&&) = delete;
+
+  thread_executor& operator=(thread_executor const&) = delete;
+  thread_executor& operator=(thread_executor&&) = delete;
+
+  ~thread_executor() = default;
+
+  inline void post(std::coroutine_handle<> handle) {
+    {
+      std::lock_guard lock{lock_};
+      handles_.push_back(handle);
+    }
+
+    ready_.notify_one();
+  }
+
+  inline std::thread::id get_id() const noexcept {
+    return thread_.get_id();
+  }
+
+private:
+  void run(std::stop_token const& stop) {
+    std::unique_lock lock{lock_};
+    while (ready_.wait(lock, stop, [this] { return !handles_.empty(); })) {
+      auto handle = handles_.front();
+      handles_.pop_front();
+
+      lock.unlock();
+      handle.resume();
+      lock.lock();
+    }
+  }
+
+private:
+  std::mutex lock_;
+  std::condition_variable_any ready_;
+  std::deque<std::coroutine_handle<>> handles_;
+
+  std::jthread thread_;
+};
+
+} // namespace frq
@@ -1,22 +1,47 @@
 #pragma once
 
+#include "dense_map.hpp"
+#include "interval_tree.hpp"
 #include "runque.hpp"
 #include "tag.hpp"
 
 #include "mutex.hpp"
 #include "task.hpp"
+#include "timer_wheel.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <optional>
+#include <span>
+#include <stop_token>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace frq {
 
+struct item_priority {
+  std::int64_t value_{0};
+};
+
 namespace detail {
+  template<typename Ty>
+  class item_handle;
+
+  template<typename Ty>
+  using item_handle_ptr = std::shared_ptr<item_handle<Ty>>;
+
   template<typename Ty>
   class item_handle {
   public:
     using value_type = Ty;
+    using duration = std::chrono::steady_clock::duration;
 
   public:
     virtual ~item_handle() {
@@ -28,10 +53,232 @@ namespace detail {
     virtual task<> finalize() = 0;
 
     virtual value_type& value() noexcept = 0;
+
+    // only handles made for sequenced and aging queues store these
+    virtual std::uint64_t sequence() const noexcept {
+      return 0;
+    }
+
+    virtual duration age() const noexcept {
+      return {};
+    }
+
+    virtual void set_age(duration /*unused*/) noexcept {
+    }
   };
 
   template<typename Ty>
-  using item_handle_ptr = std::shared_ptr<item_handle<Ty>>;
+  class intrusive_handle;
+
+  template<typename Ty>
+  struct item_hook {
+    item_handle_ptr<Ty> self_;
+    intrusive_handle<Ty>* next_{nullptr};
+    intrusive_handle<Ty>* child_{nullptr};
+
+    std::size_t index_{0};
+    std::uint64_t order_{0};
+    std::int64_t priority_{0};
+  };
+
+  template<typename Ty>
+  class intrusive_handle : public item_handle<Ty> {
+  public:
+    item_hook<Ty> hook_;
+  };
+
+  struct no_item_sequence {};
+  struct no_item_age {};
+  struct no_item_priority {};
+  struct no_item_queued {};
+
+  template<bool Sequenced>
+  using item_sequence_t =
+      std::conditional_t<Sequenced, std::uint64_t, no_item_sequence>;
+
+  template<bool Inheriting>
+  using item_priority_t =
+      std::conditional_t<Inheriting, std::int64_t, no_item_priority>;
+
+  // handles carry only the fields the queue policy reads: links for
+  // intrusive queues, the reservation sequence and the age in the queue
+  template<typename Ty, bool Intrusive, bool Sequenced, bool Aging>
+  class item_node : public std::conditional_t<Intrusive,
+                                              intrusive_handle<Ty>,
+                                              item_handle<Ty>> {
+  public:
+    using duration = typename item_handle<Ty>::duration;
+
+  public:
+    std::uint64_t sequence() const noexcept override {
+      if constexpr (Sequenced) {
+        return sequence_;
+      }
+      else {
+        return 0;
+      }
+    }
+
+    duration age() const noexcept override {
+      if constexpr (Aging) {
+        return age_;
+      }
+      else {
+        return {};
+      }
+    }
+
+    void set_age([[maybe_unused]] duration age) noexcept override {
+      if constexpr (Aging) {
+        age_ = age;
+      }
+    }
+
+    [[no_unique_address]] item_sequence_t<Sequenced> sequence_{};
+    [[no_unique_address]] std::conditional_t<Aging, duration, no_item_age>
+        age_{};
+  };
+
+  class item_barrier {
+  public:
+    virtual ~item_barrier() {
+    }
+
+    virtual task<> arrive() = 0;
+  };
+
+  class passed_barrier final : public item_barrier {
+  public:
+    task<> arrive() override {
+      co_return;
+    }
+  };
+
+  inline item_barrier& get_passed_barrier() noexcept {
+    static passed_barrier barrier{};
+    return barrier;
+  }
+
+  template<typename Ty, bool Sequenced, bool Inheriting>
+  struct item_slot {
+    inline bool ready() const noexcept {
+      return value_.has_value() || barrier_ != nullptr;
+    }
+
+    std::optional<Ty> value_{};
+    item_barrier* barrier_{nullptr};
+    [[no_unique_address]] item_sequence_t<Sequenced> sequence_{};
+
+    [[no_unique_address]] item_priority_t<Inheriting> priority_{};
+    [[no_unique_address]] std::conditional_t<Inheriting,
+                                             std::weak_ptr<item_handle<Ty>>,
+                                             no_item_queued> queued_{};
+  };
+
+  inline std::uint64_t next_sequence() noexcept {
+    static std::atomic<std::uint64_t> sequence{0};
+    return sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // the queue that finally stores the items, looking through runques that
+  // only wrap another one
+  template<typename Ty>
+  struct runque_queue {
+    using type = void;
+  };
+
+  template<typename Ty>
+  requires requires(Ty& runque) { runque.get_queue(); }
+  struct runque_queue<Ty> {
+    using type =
+        std::remove_reference_t<decltype(std::declval<Ty&>().get_queue())>;
+  };
+
+  template<typename Ty>
+  requires(requires { typename Ty::runque_type; } &&
+           !requires(Ty& runque) { runque.get_queue(); })
+  struct runque_queue<Ty> : runque_queue<typename Ty::runque_type> {};
+
+  template<typename Ty>
+  using runque_queue_t = typename runque_queue<Ty>::type;
+
+  template<typename Ty>
+  concept sequenced_runque = requires {
+    requires runque_queue_t<Ty>::is_sequenced;
+  };
+
+  template<typename Ty>
+  concept aging_runque = requires {
+    requires runque_queue_t<Ty>::is_aging;
+  };
+
+  template<typename Ty>
+  concept intrusive_runque = requires {
+    requires runque_queue_t<Ty>::is_intrusive;
+  };
+
+  template<typename Ty>
+  concept inheriting_runque = requires(Ty& runque) {
+    requires std::remove_reference_t<decltype(runque.get_queue())>::
+        is_inheriting;
+  };
+
+  // blocking runques complete these calls in place while coroutine runques
+  // return a task, so the chains wrap them to co_await either kind
+
+  template<typename Ty>
+  concept awaitable_runque = std::same_as<typename Ty::get_type,
+                                          task<typename Ty::value_type>>;
+
+  template<runlike Runque>
+  inline auto runque_put(Runque& runque,
+                         typename Runque::value_type&& value) {
+    if constexpr (awaitable_runque<Runque>) {
+      return runque.put(std::move(value));
+    }
+    else {
+      runque.put(std::move(value));
+      return std::suspend_never{};
+    }
+  }
+
+  template<batch_runlike Runque>
+  inline auto
+      runque_put_many(Runque& runque,
+                      std::span<typename Runque::value_type> values) {
+    if constexpr (awaitable_runque<Runque>) {
+      return runque.put_many(values);
+    }
+    else {
+      runque.put_many(values);
+      return std::suspend_never{};
+    }
+  }
+
+  template<runlike Runque>
+  inline auto runque_interrupt(Runque& runque) {
+    if constexpr (awaitable_runque<Runque>) {
+      return runque.interrupt();
+    }
+    else {
+      runque.interrupt();
+      return std::suspend_never{};
+    }
+  }
+
+  template<runlike Runque, typename Fn>
+  inline auto runque_with_queue(Runque& runque, Fn fn) {
+    if constexpr (awaitable_runque<Runque>) {
+      return runque.with_queue(std::move(fn));
+    }
+    else {
+      runque.with_queue(std::move(fn));
+      return std::suspend_never{};
+    }
+  }
+
+  struct reservation_access;
+  struct retainment_access;
 } // namespace detail
 
 template<typename Ty>
@@ -42,7 +289,7 @@ public:
 public:
   explicit inline retainment(
       detail::item_handle_ptr<value_type>&& handle) noexcept
-      : handle_{handle} {
+      : handle_{std::move(handle)} {
   }
 
   inline task<void> finalize() {
@@ -57,8 +304,18 @@ public:
     return handle_->value();
   }
 
+  inline std::uint64_t sequence() const noexcept {
+    return handle_->sequence();
+  }
+
+  inline std::chrono::steady_clock::duration age() const noexcept {
+    return handle_->age();
+  }
+
 private:
   detail::item_handle_ptr<value_type> handle_;
+
+  friend detail::retainment_access;
 };
 
 template<typename Ty>
@@ -69,7 +326,7 @@ public:
 public:
   explicit inline reservation(
       detail::item_handle_ptr<value_type>&& handle) noexcept
-      : handle_{handle} {
+      : handle_{std::move(handle)} {
   }
 
   inline task<> release(value_type&& value) {
@@ -82,9 +339,78 @@ public:
 
 private:
   detail::item_handle_ptr<value_type> handle_;
+
+  friend detail::reservation_access;
 };
 
 namespace detail {
+  struct reservation_access {
+    template<typename Ty>
+    static inline item_handle_ptr<Ty> const&
+        handle(reservation<Ty> const& target) noexcept {
+      return target.handle_;
+    }
+  };
+
+  struct retainment_access {
+    // forque makes intrusive handles for the runques that queue them
+    template<typename Ty>
+    static inline intrusive_handle<Ty>*
+        link(retainment<Ty>&& target) noexcept {
+      auto handle = static_cast<intrusive_handle<Ty>*>(target.handle_.get());
+      handle->hook_.self_ = std::move(target.handle_);
+
+      return handle;
+    }
+
+    template<typename Ty>
+    static inline retainment<Ty>
+        unlink(intrusive_handle<Ty>* handle) noexcept {
+      handle->hook_.next_ = nullptr;
+      handle->hook_.child_ = nullptr;
+
+      return retainment<Ty>{std::move(handle->hook_.self_)};
+    }
+
+    template<typename Ty>
+    static inline void
+        set_age(retainment<Ty>& target,
+                std::chrono::steady_clock::duration age) noexcept {
+      target.handle_->set_age(age);
+    }
+  };
+
+  template<typename Ty>
+  struct item_age<retainment<Ty>> {
+    using duration = std::chrono::steady_clock::duration;
+
+    static inline void set(retainment<Ty>& value, duration age) noexcept {
+      retainment_access::set_age(value, age);
+    }
+  };
+
+  template<typename Key, typename Value, typename Alloc>
+  struct children_map {
+    using type = std::unordered_map<Key,
+                                    Value,
+                                    std::hash<Key>,
+                                    std::equal_to<Key>,
+                                    Alloc>;
+  };
+
+  template<bounded_tag_key Key, typename Value, typename Alloc>
+  struct children_map<Key, Value, Alloc> {
+    using type = dense_map<Key, Value, Alloc>;
+  };
+
+  template<typename Ty, typename Value, typename Alloc>
+  struct children_map<interval<Ty>, Value, Alloc> {
+    using type = interval_tree<Ty, Value, Alloc>;
+  };
+
+  template<typename Key, typename Value, typename Alloc>
+  using children_map_t = typename children_map<Key, Value, Alloc>::type;
+
   template<typename Ty,
            taglike LevelTag,
            runlike Runque,
@@ -109,26 +435,80 @@ namespace detail {
     using key_type = tag_key_t<level_tag_type>;
     using next_key_type = tag_key_t<next_tag_type>;
 
+    using size_type = typename level_tag_type::size_type;
+
     using next_type =
         chain<value_type, next_tag_type, runque_type, allocator_type>;
     using prev_type =
         chain<value_type, prev_tag_type, runque_type, allocator_type>;
 
+    static constexpr bool is_static = tag_traits<level_tag_type>::is_static;
+    static constexpr bool is_ranged = interval_key<next_key_type>;
+
+    using child_holder = std::conditional_t<
+        is_static,
+        next_type,
+        detail::alloc_ptr<next_type,
+                          detail::rebind_alloc_t<allocator_type, next_type>>>;
+
+    static constexpr bool is_sequenced = sequenced_runque<runque_type>;
+    static constexpr bool is_inheriting = inheriting_runque<runque_type>;
+
+    static_assert(!is_inheriting || intrusive_runque<runque_type>);
+
+    using handle_type = item_node<value_type,
+                                  intrusive_runque<runque_type>,
+                                  is_sequenced,
+                                  aging_runque<runque_type>>;
+    using slot_type = item_slot<value_type, is_sequenced, is_inheriting>;
+
+    using sequence_type = item_sequence_t<is_sequenced>;
+    using priority_type = item_priority_t<is_inheriting>;
+
     using sibling_list =
-        std::list<storage_type,
-                  detail::rebind_alloc_t<allocator_type, storage_type>>;
+        std::list<slot_type, detail::rebind_alloc_t<allocator_type, slot_type>>;
     using sibling_iter = typename sibling_list::iterator;
 
-    using next_allocator_type =
-        detail::rebind_alloc_t<allocator_type, next_type>;
+    class wildcard_handle_impl;
+
+    using wildcard_ptr = std::shared_ptr<wildcard_handle_impl>;
+    using wildcard_list = std::conditional_t<
+        is_static,
+        std::tuple<>,
+        std::list<wildcard_ptr,
+                  detail::rebind_alloc_t<allocator_type, wildcard_ptr>>>;
+
+    struct range_item {
+      using node_type =
+          interval_node<typename next_key_type::value_type, range_item>;
+
+      inline range_item(storage_type&& value,
+                        std::size_t blockers,
+                        sequence_type sequence,
+                        priority_type priority) noexcept
+          : value_{std::move(value)}
+          , blockers_{blockers}
+          , sequence_{sequence}
+          , priority_{priority} {
+      }
 
-    using children_map = std::unordered_map<
-        next_key_type,
-        next_type,
-        std::hash<next_key_type>,
-        std::equal_to<next_key_type>,
+      storage_type value_;
+      std::size_t blockers_;
+      [[no_unique_address]] sequence_type sequence_;
+      [[no_unique_address]] priority_type priority_;
+      node_type* next_ready_{nullptr};
+    };
+
+    using child_type =
+        std::conditional_t<is_ranged, range_item, child_holder>;
+
+    using children_alloc_type =
         detail::rebind_alloc_t<allocator_type,
-                               std::pair<const next_key_type, next_type>>>;
+                               std::pair<const next_key_type, child_type>>;
+
+    using children_map =
+        children_map_t<next_key_type, child_type, children_alloc_type>;
+    using children_iter = typename children_map::iterator;
 
     struct segment {
       inline bool forked() const noexcept {
@@ -141,6 +521,7 @@ namespace detail {
 
       sibling_list siblings_;
       children_map children_;
+      [[no_unique_address]] wildcard_list wildcards_{};
       std::uint64_t version_{0};
       bool active_;
     };
@@ -149,7 +530,11 @@ namespace detail {
     using segment_list = std::list<segment, segment_alloc_type>;
     using segment_iter = typename segment_list::iterator;
 
-    class item_handle_impl : public item_handle<value_type> {
+    using ready_list =
+        std::vector<retainment_type,
+                    detail::rebind_alloc_t<allocator_type, retainment_type>>;
+
+    class item_handle_impl : public handle_type {
     public:
       inline item_handle_impl(sibling_iter position,
                               segment_iter segment,
@@ -172,8 +557,8 @@ namespace detail {
       }
 
       value_type& value() noexcept override {
-        assert(*position_);
-        return position_->value();
+        assert(position_->value_);
+        return position_->value_.value();
       }
 
     private:
@@ -182,6 +567,137 @@ namespace detail {
       chain* owner_;
     };
 
+    class wildcard_handle_impl
+        : public handle_type
+        , public item_barrier
+        , public std::enable_shared_from_this<wildcard_handle_impl> {
+    private:
+      using handle_ptr = item_handle_ptr<value_type>;
+      using part_list =
+          std::vector<handle_ptr,
+                      detail::rebind_alloc_t<allocator_type, handle_ptr>>;
+
+    public:
+      inline wildcard_handle_impl(chain& owner,
+                                  segment_iter segment,
+                                  next_tag_type const& tag,
+                                  slot_type&& slot)
+          : owner_{&owner}
+          , segment_{segment}
+          , tag_{tag}
+          , value_{std::move(slot.value_)}
+          , barrier_{slot.barrier_}
+          , pending_{slot.ready() ? 1U : 2U}
+          , parts_{owner.segments_.get_allocator()} {
+        this->sequence_ = slot.sequence_;
+        if constexpr (is_inheriting) {
+          this->hook_.priority_ = slot.priority_;
+        }
+      }
+
+      task<> release(value_type&& value) override {
+        value_ = std::move(value);
+        co_await arrive();
+      }
+
+      task<> release(value_type const& value) override {
+        value_ = value;
+        co_await arrive();
+      }
+
+      task<> finalize() override {
+        co_await owner_->finalize_wildcard(*this);
+      }
+
+      value_type& value() noexcept override {
+        assert(value_);
+        return value_.value();
+      }
+
+      task<> arrive() override {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          if (barrier_ != nullptr) {
+            co_await barrier_->arrive();
+          }
+          else {
+            co_await detail::runque_put(
+                *owner_->runque_, retainment_type{this->shared_from_this()});
+          }
+        }
+      }
+
+      item_barrier& join() noexcept {
+        auto pending = pending_.load(std::memory_order_relaxed);
+        while (pending != 0) {
+          if (pending_.compare_exchange_weak(pending,
+                                             pending + 1,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+            return *this;
+          }
+        }
+
+        return get_passed_barrier();
+      }
+
+      next_tag_type part_tag(next_key_type const& key) const {
+        auto values = tag_.values();
+        values[owner_->depth()] = key;
+
+        return next_tag_type{
+            values.get_allocator(), values.begin(), values.end()};
+      }
+
+    private:
+      chain* owner_;
+      segment_iter segment_;
+      typename wildcard_list::iterator position_;
+
+      next_tag_type tag_;
+      storage_type value_;
+
+      item_barrier* barrier_;
+      std::atomic<std::size_t> pending_;
+
+      part_list parts_;
+      handle_ptr star_;
+
+      friend chain;
+    };
+
+    class range_handle_impl : public handle_type {
+    public:
+      inline range_handle_impl(children_iter position,
+                               segment_iter segment,
+                               chain& owner) noexcept
+          : position_{position}
+          , segment_{segment}
+          , owner_{&owner} {
+      }
+
+      task<> release(value_type&& value) override {
+        co_await owner_->release_range(position_, segment_, std::move(value));
+      }
+
+      task<> release(value_type const& value) override {
+        co_await owner_->release_range(position_, segment_, value);
+      }
+
+      task<> finalize() override {
+        co_await owner_->finalize_range(position_, segment_);
+      }
+
+      value_type& value() noexcept override {
+        assert(position_->payload_.value_);
+        return position_->payload_.value_.value();
+      }
+
+    private:
+      children_iter position_;
+      segment_iter segment_;
+      chain* owner_;
+    };
+
   public:
     inline chain(runque_type& runque,
                  prev_type* parent,
@@ -191,21 +707,39 @@ namespace detail {
         : runque_{&runque}
         , parent_{parent}
         , tag_{std::move(tag)}
+        , base_{parent != nullptr ? parent->depth() : size_type{}}
         , segments_{segment_alloc_type{alloc}} {
       segments_.push_back(segment{.active_ = active});
     }
 
     template<viewlike View>
-    task<reservation_type> reserve(View view, storage_type&& value) {
+    task<reservation_type> reserve(View view,
+                                   storage_type&& value,
+                                   item_priority priority = {}) {
       co_await mutex_.lock();
-      mutex_guard guard{mutex_, std::adopt_lock};
 
-      if (interrupted_) {
-        throw frq::interrupted{};
+      co_return co_await reserve_locked(std::move(view),
+                                        std::move(value),
+                                        priority,
+                                        mutex_guard{mutex_, std::adopt_lock});
+    }
+
+    template<viewlike View>
+    task<std::optional<reservation_type>>
+        reserve_until(View view,
+                      storage_type&& value,
+                      timer_wheel::time_point deadline,
+                      timer_wheel& timers,
+                      item_priority priority = {}) {
+      auto acquired = co_await mutex_.lock_until(deadline, timers);
+      if (!acquired) {
+        co_return std::nullopt;
       }
 
-      co_return co_await reserve(
-          std::move(view), std::move(value), std::move(guard));
+      co_return co_await reserve_locked(std::move(view),
+                                        std::move(value),
+                                        priority,
+                                        mutex_guard{mutex_, std::adopt_lock});
     }
 
     task<> interrupt() noexcept {
@@ -216,59 +750,93 @@ namespace detail {
         interrupted_ = true;
 
         if (segments_.front().empty()) {
-          co_await runque_->interrupt();
+          co_await detail::runque_interrupt(*runque_);
         }
       }
     }
 
   private:
+    template<viewlike View>
+    task<reservation_type> reserve_locked(View view,
+                                          storage_type&& value,
+                                          item_priority priority,
+                                          mutex_guard&& guard) {
+      if (interrupted_) {
+        throw frq::interrupted{};
+      }
+
+      slot_type slot{.value_ = std::move(value)};
+      if constexpr (is_sequenced) {
+        slot.sequence_ = next_sequence();
+      }
+
+      if constexpr (is_inheriting) {
+        slot.priority_ = priority.value_;
+      }
+
+      co_return co_await reserve(
+          std::move(view), std::move(slot), std::move(guard));
+    }
+
     template<viewlike View>
     task<reservation_type>
-        reserve(View view, storage_type&& value, mutex_guard&& guard) {
+        reserve(View view, slot_type&& slot, mutex_guard&& guard) {
       using view_traits = tag_view_traits<View>;
 
+      if constexpr (is_inheriting) {
+        co_await inherit(slot.priority_, segments_.size() > 1);
+      }
+
       if constexpr (tag_traits<level_tag_type>::is_root) {
         co_return co_await reserve_child(
-            view, std::move(value), std::move(guard));
+            view, std::move(slot), std::move(guard));
       }
       else if constexpr (view_traits::is_last) {
-        co_return co_await add_sibling(std::move(value));
+        co_return co_await add_sibling(std::move(slot));
       }
       else if constexpr (view_traits::is_static) {
         co_return co_await reserve_child(
-            view.next(), std::move(value), std::move(guard));
+            view.next(), std::move(slot), std::move(guard));
       }
       else {
-        if (view.last()) {
-          co_return co_await add_sibling(std::move(value));
+        if (depth() == 0) {
+          co_return co_await reserve_child(
+              view, std::move(slot), std::move(guard));
+        }
+        else if (view.last()) {
+          co_return co_await add_sibling(std::move(slot));
         }
         else {
           co_return co_await reserve_child(
-              view.next(), std::move(value), std::move(guard));
+              view.next(), std::move(slot), std::move(guard));
         }
       }
     }
 
-    task<reservation_type> add_sibling(storage_type&& value) {
+    task<reservation_type> add_sibling(slot_type&& slot) {
       using alloc_type =
           detail::rebind_alloc_t<allocator_type, item_handle_impl>;
 
       if (segments_.empty() || segments_.back().forked()) {
+        if constexpr (is_inheriting) {
+          if (segments_.size() == 1) {
+            co_await inherit(slot.priority_, true);
+          }
+        }
+
         segments_.push_back({});
       }
 
       auto segment_pos = prev(segments_.end());
       auto& siblings = segment_pos->siblings_;
 
-      bool ready =
-          value.has_value() && segment_pos->active_ && siblings.empty();
+      bool ready = slot.ready() && segment_pos->active_ && siblings.empty();
 
-      siblings.push_back(std::move(value));
+      siblings.push_back(std::move(slot));
       ++segment_pos->version_;
 
       if (ready) {
-        co_await runque_->put(
-            retainment_type{make_handle(segment_pos, siblings.begin())});
+        co_await schedule(segment_pos, siblings.begin());
       }
 
       co_return reservation_type{
@@ -277,16 +845,161 @@ namespace detail {
 
     template<viewlike View>
     task<reservation_type>
-        reserve_child(View view, storage_type&& value, mutex_guard&& guard) {
-      auto& child = ensure_child(view);
+        reserve_child(View view, slot_type&& slot, mutex_guard&& guard) {
+      if constexpr (is_ranged) {
+        static_assert(tag_view_traits<View>::is_last,
+                      "interval keys are only supported at the last level");
+
+        assert(slot.barrier_ == nullptr);
+        co_return co_await add_range(view.key(), std::move(slot));
+      }
+      else if constexpr (is_static) {
+        auto& child = ensure_child(view);
+
+        co_await child.mutex_.lock();
+        mutex_guard guard_child{child.mutex_, std::adopt_lock};
+
+        sink(guard);
+
+        co_return co_await child.reserve(
+            view, std::move(slot), std::move(guard_child));
+      }
+      else {
+        if (view.key().wildcard()) {
+          co_return co_await add_wildcard(
+              view, std::move(slot), std::move(guard));
+        }
+
+        co_return co_await reserve_path(
+            view, std::move(slot), std::move(guard));
+      }
+    }
+
+    template<viewlike View>
+    task<reservation_type>
+        reserve_path(View view, slot_type&& slot, mutex_guard&& guard) {
+      auto& segment = get_segment();
+      auto& children = segment.children_;
+
+      auto child_pos = children.find(view.key());
+      if (child_pos == children.end()) {
+        child_pos = add_child(view);
+
+        if (!view.key().wildcard()) {
+          for (auto& wildcard : segment.wildcards_) {
+            co_await add_part(*wildcard, view.key(), wildcard->join());
+          }
+        }
+      }
+
+      auto& child = *child_pos->second;
 
       co_await child.mutex_.lock();
       mutex_guard guard_child{child.mutex_, std::adopt_lock};
 
+      auto matched = child.match(view);
+      if (matched != child.depth()) {
+        if (child.empty()) {
+          child.tag_ = bounded_tag(view);
+          matched = child.depth();
+        }
+        else {
+          auto& upper = split_child(child_pos, matched);
+
+          co_await upper.mutex_.lock();
+          mutex_guard guard_upper{upper.mutex_, std::adopt_lock};
+
+          sink(guard_child);
+          sink(guard);
+
+          co_return co_await upper.reserve(view.at(matched - 1),
+                                           std::move(slot),
+                                           std::move(guard_upper));
+        }
+      }
+
       sink(guard);
 
       co_return co_await child.reserve(
-          view, std::move(value), std::move(guard_child));
+          view.at(matched - 1), std::move(slot), std::move(guard_child));
+    }
+
+    template<viewlike View>
+    task<reservation_type>
+        add_wildcard(View view, slot_type&& slot, mutex_guard&& guard) {
+      using alloc_type =
+          detail::rebind_alloc_t<allocator_type, wildcard_handle_impl>;
+      using key_alloc_type =
+          detail::rebind_alloc_t<allocator_type, next_key_type>;
+
+      auto segment_pos = prev(segments_.end());
+      auto& segment = get_segment();
+
+      auto wildcard = std::allocate_shared<wildcard_handle_impl>(
+          alloc_type{segments_.get_allocator()},
+          *this,
+          segment_pos,
+          view.tag(),
+          std::move(slot));
+
+      std::vector<next_key_type, key_alloc_type> keys{
+          key_alloc_type{segments_.get_allocator()}};
+      for (auto& [key, _] : segment.children_) {
+        if (!key.wildcard()) {
+          keys.push_back(key);
+        }
+      }
+
+      for (auto& key : keys) {
+        co_await add_part(*wildcard, key, wildcard->join());
+      }
+
+      wildcard->position_ =
+          segment.wildcards_.insert(segment.wildcards_.end(), wildcard);
+
+      auto star = co_await reserve_path(
+          view,
+          slot_type{.barrier_ = &wildcard->join()},
+          std::move(guard));
+
+      wildcard->star_ = reservation_access::handle(star);
+      co_await wildcard->arrive();
+
+      co_return reservation_type{std::move(wildcard)};
+    }
+
+    task<> add_part(wildcard_handle_impl& wildcard,
+                    next_key_type const& key,
+                    item_barrier& barrier) {
+      auto tag = wildcard.part_tag(key);
+
+      auto part = co_await reserve_path(frq::view(tag).at(depth()),
+                                        slot_type{.barrier_ = &barrier},
+                                        mutex_guard{});
+
+      wildcard.parts_.push_back(reservation_access::handle(part));
+    }
+
+    task<reservation_type> add_range(next_key_type const& range,
+                                     slot_type&& slot) {
+      auto segment_pos = prev(segments_.end());
+      auto& ranges = get_segment().children_;
+
+      std::size_t blockers{0};
+      ranges.overlaps(range, [&blockers](auto& /*unused*/) { ++blockers; });
+
+      auto range_pos = ranges.insert(range,
+                                     std::move(slot.value_),
+                                     blockers,
+                                     slot.sequence_,
+                                     slot.priority_);
+      if (is_range_ready(segment_pos, range_pos->payload_)) {
+        co_await detail::runque_put(
+            *runque_,
+            retainment_type{make_range_handle(segment_pos, range_pos)});
+      }
+
+      co_return reservation_type{make_range_handle(segment_pos, range_pos)};
     }
 
     template<viewlike View>
@@ -309,6 +1022,82 @@ namespace detail {
       return pos->second;
     }
 
+    template<viewlike View>
+    children_iter add_child(View view) {
+      auto& segment = segments_.back();
+      auto& children = segment.children_;
+
+      auto active = segment.active_ && segment.siblings_.empty();
+
+      auto [pos, result] =
+          children.emplace(std::piecewise_construct,
+                           std::forward_as_tuple(view.key()),
+                           std::forward_as_tuple(std::allocator_arg,
+                                                 children.get_allocator(),
+                                                 *runque_,
+                                                 this,
+                                                 bounded_tag(view),
+                                                 active,
+                                                 children.get_allocator()));
+
+      return pos;
+    }
+
+    next_type& split_child(children_iter child_pos, size_type depth) {
+      auto& lower = *child_pos->second;
+      auto& values = lower.tag_.values();
+
+      child_holder upper{
+          std::allocator_arg,
+          segments_.get_allocator(),
+          *runque_,
+          this,
+          next_tag_type{values.get_allocator(),
+                        values.begin(),
+                        values.begin() + depth},
+          lower.segments_.front().active_,
+          segments_.get_allocator()};
+
+      lower.base_ = depth;
+      lower.parent_.store(upper.get(), std::memory_order_relaxed);
+
+      upper->segments_.front().children_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(lower.get_key()),
+          std::forward_as_tuple(std::move(child_pos->second)));
+
+      child_pos->second = std::move(upper);
+      return *child_pos->second;
+    }
+
+    template<viewlike View>
+    next_tag_type bounded_tag(View view) const {
+      auto& values = view.tag().values();
+
+      auto last = std::find_if(values.begin() + view.level() + 1,
+                               values.end(),
+                               [](auto const& value) {
+                                 return value.wildcard();
+                               });
+
+      return next_tag_type{values.get_allocator(), values.begin(), last};
+    }
+
+    template<viewlike View>
+    size_type match(View view) const noexcept {
+      auto& values = tag_.values();
+      auto& other = view.tag().values();
+
+      auto last = std::min(depth(), view.tag().size());
+
+      auto level = base_ + 1;
+      while (level < last && values[level] == other[level]) {
+        ++level;
+      }
+
+      return level;
+    }
+
     auto& get_segment() {
       auto& segment = segments_.back();
       ++segment.version_;
@@ -327,21 +1116,118 @@ namespace detail {
       co_await mutex_.lock();
       mutex_guard guard{mutex_, std::adopt_lock};
 
-      assert(!*sibling_pos);
-      *sibling_pos = std::forward<Tx>(value);
+      assert(!sibling_pos->value_);
+      sibling_pos->value_ = std::forward<Tx>(value);
 
       if (segment_pos->active_ && segment_pos == begin(segments_) &&
           sibling_pos == begin(segment_pos->siblings_)) {
-        co_await runque_->put(
-            retainment_type{make_handle(segment_pos, sibling_pos)});
+        co_await put_sibling(segment_pos, sibling_pos);
       }
     }
 
-    task<> finalize(segment_iter segment_pos) {
-      co_await parent_->mutex_.lock();
-      mutex_guard guard_parent{parent_->mutex_, std::adopt_lock};
-
+    template<typename Tx>
+    task<> release_range(
+        children_iter range_pos,
+        segment_iter segment_pos,
+        Tx&& value) requires(std::
+                                 is_assignable_v<
+                                     std::add_lvalue_reference_t<value_type>,
+                                     decltype(value)>) {
       co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      auto& item = range_pos->payload_;
+
+      assert(!item.value_);
+      item.value_ = std::forward<Tx>(value);
+
+      if (is_range_ready(segment_pos, item)) {
+        co_await detail::runque_put(
+            *runque_,
+            retainment_type{make_range_handle(segment_pos, range_pos)});
+      }
+    }
+
+    task<> finalize_range(children_iter range_pos, segment_iter segment_pos) {
+      auto parent = co_await lock_with_parent();
+      mutex_guard guard_parent{parent->mutex_, std::adopt_lock};
+      mutex_guard guard_owner{mutex_, std::adopt_lock};
+
+      auto& ranges = segment_pos->children_;
+
+      auto range = range_pos->range_;
+      auto order = range_pos->order_;
+
+      ranges.erase(range_pos);
+
+      children_iter ready{nullptr};
+      auto tail = &ready;
+
+      ranges.overlaps(range, [order, &tail](auto& other) {
+        auto& item = other.payload_;
+        if (order < other.order_ && --item.blockers_ == 0 && item.value_) {
+          tail = append_ready(tail, other);
+        }
+      });
+
+      if (ranges.empty()) {
+        co_await next_segment(
+            segment_pos, std::move(guard_parent), std::move(guard_owner));
+        co_return;
+      }
+
+      sink(guard_parent);
+
+      auto batch = make_ready_list();
+      collect_ranges(segment_pos, ready, batch);
+
+      co_await put_ready(batch);
+    }
+
+    void collect_ranges(segment_iter segment_pos,
+                        children_iter ready,
+                        ready_list& batch) {
+      while (ready != nullptr) {
+        auto range_pos = std::exchange(ready, ready->payload_.next_ready_);
+        batch.emplace_back(make_range_handle(segment_pos, range_pos));
+      }
+    }
+
+    inline ready_list make_ready_list() const {
+      using alloc_type =
+          detail::rebind_alloc_t<allocator_type, retainment_type>;
+      return ready_list{alloc_type{segments_.get_allocator()}};
+    }
+
+    task<> put_ready(ready_list& batch) {
+      if constexpr (batch_runlike<runque_type>) {
+        if (!batch.empty()) {
+          co_await detail::runque_put_many(*runque_, std::span{batch});
+        }
+      }
+      else {
+        for (auto& item : batch) {
+          co_await detail::runque_put(*runque_, std::move(item));
+        }
+      }
+    }
+
+    static inline children_iter* append_ready(children_iter* tail,
+                                              auto& node) noexcept {
+      node.payload_.next_ready_ = nullptr;
+      *tail = &node;
+      return &node.payload_.next_ready_;
+    }
+
+    inline bool is_range_ready(segment_iter segment_pos,
+                               range_item const& item) const noexcept {
+      return item.value_ && item.blockers_ == 0 && segment_pos->active_ &&
+             segment_pos->siblings_.empty();
+    }
+
+    task<> finalize(segment_iter segment_pos) {
+      auto parent = co_await lock_with_parent();
+      mutex_guard guard_parent{parent->mutex_, std::adopt_lock};
       mutex_guard guard_owner{mutex_, std::adopt_lock};
 
       segment_pos->siblings_.pop_front();
@@ -367,47 +1253,169 @@ namespace detail {
 
     task<> activate_sibling(segment_iter segment_pos) {
       auto sibling_pos = segment_pos->siblings_.begin();
-      if (*sibling_pos) {
-        co_await runque_->put(
-            retainment_type{make_handle(segment_pos, sibling_pos)});
+      if (sibling_pos->ready()) {
+        co_await schedule(segment_pos, sibling_pos);
+      }
+    }
+
+    task<> schedule(segment_iter segment_pos, sibling_iter sibling_pos) {
+      if (sibling_pos->barrier_ != nullptr) {
+        co_await sibling_pos->barrier_->arrive();
+      }
+      else {
+        co_await put_sibling(segment_pos, sibling_pos);
+      }
+    }
+
+    task<> put_sibling(segment_iter segment_pos, sibling_iter sibling_pos) {
+      co_await detail::runque_put(*runque_,
+                                  make_queued(segment_pos, sibling_pos));
+    }
+
+    inline retainment_type make_queued(segment_iter segment_pos,
+                                       sibling_iter sibling_pos) {
+      auto handle = make_handle(segment_pos, sibling_pos);
+      if constexpr (is_inheriting) {
+        sibling_pos->queued_ = handle;
       }
+
+      return retainment_type{std::move(handle)};
+    }
+
+    // an item behind the front segment waits for its head sibling or, when
+    // it has none, for every child branch it forked into; ranged children
+    // are not raised
+    task<> inherit(std::int64_t priority, bool behind) {
+      auto& front = segments_.front();
+      auto& siblings = front.siblings_;
+
+      if (siblings.empty()) {
+        if constexpr (!is_ranged) {
+          if (behind) {
+            for (auto& [_, child] : front.children_) {
+              co_await get_child(child).inherit_front(priority);
+            }
+          }
+        }
+
+        co_return;
+      }
+
+      if (priority <= siblings.front().priority_) {
+        co_return;
+      }
+
+      auto& head = siblings.front();
+      head.priority_ = priority;
+
+      if (auto handle = head.queued_.lock(); handle) {
+        co_await detail::runque_with_queue(
+            *runque_, [&handle, priority](auto& queue) {
+              queue.boost(handle.get(), priority);
+            });
+      }
+    }
+
+    task<> inherit_front(std::int64_t priority) {
+      co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      co_await inherit(priority, true);
+    }
+
+    task<> finalize_wildcard(wildcard_handle_impl& wildcard) {
+      co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      wildcard.segment_->wildcards_.erase(wildcard.position_);
+      auto parts = std::move(wildcard.parts_);
+
+      sink(guard);
+
+      for (auto& part : parts) {
+        co_await part->finalize();
+      }
+
+      co_await wildcard.star_->finalize();
     }
 
     task<> activate_children(segment_iter segment_pos) {
-      for (auto& [_, child] : segment_pos->children_) {
-        co_await child.activate_segment();
+      auto batch = make_ready_list();
+      co_await activate_children(segment_pos, batch);
+
+      co_await put_ready(batch);
+    }
+
+    task<> activate_children(segment_iter segment_pos, ready_list& batch) {
+      if constexpr (is_ranged) {
+        children_iter ready{nullptr};
+        auto tail = &ready;
+
+        segment_pos->children_.for_each([&tail](auto& node) {
+          auto& item = node.payload_;
+          if (item.blockers_ == 0 && item.value_) {
+            tail = append_ready(tail, node);
+          }
+        });
+
+        collect_ranges(segment_pos, ready, batch);
+      }
+      else {
+        for (auto& [_, child] : segment_pos->children_) {
+          co_await get_child(child).activate_segment(batch);
+        }
       }
     }
 
     task<> activate_segment(segment_iter segment_pos) {
+      auto batch = make_ready_list();
+      co_await activate_segment(segment_pos, batch);
+
+      co_await put_ready(batch);
+    }
+
+    task<> activate_segment(segment_iter segment_pos, ready_list& batch) {
       segment_pos->active_ = true;
       if (!segment_pos->siblings_.empty()) {
-        co_await activate_sibling(segment_pos);
+        auto sibling_pos = segment_pos->siblings_.begin();
+        if (!sibling_pos->ready()) {
+          co_return;
+        }
+
+        if (sibling_pos->barrier_ != nullptr) {
+          co_await sibling_pos->barrier_->arrive();
+        }
+        else {
+          batch.push_back(make_queued(segment_pos, sibling_pos));
+        }
       }
       else {
-        co_await activate_children(segment_pos);
+        co_await activate_children(segment_pos, batch);
       }
     }
 
-    task<> activate_segment() {
+    task<> activate_segment(ready_list& batch) {
       co_await mutex_.lock();
       mutex_guard guard{mutex_, std::adopt_lock};
 
-      co_await activate_segment(segments_.begin());
+      co_await activate_segment(segments_.begin(), batch);
     }
 
-    task<> remove_child(next_tag_type const& tag, std::uint64_t version) {
-      co_await parent_->mutex_.lock();
-      mutex_guard guard_parent{parent_->mutex_, std::adopt_lock};
-
-      co_await mutex_.lock();
+    task<> remove_child(next_key_type const& key,
+                        next_type const* target,
+                        std::uint64_t version) {
+      auto parent = co_await lock_with_parent();
+      mutex_guard guard_parent{parent->mutex_, std::adopt_lock};
       mutex_guard guard_this{mutex_, std::adopt_lock};
 
       auto segment_pos = segments_.begin();
-      auto child_pos = segment_pos->children_.find(tag.key());
+      auto child_pos = segment_pos->children_.find(key);
 
       if (child_pos != segment_pos->children_.end()) {
-        auto& [child_key, child] = *child_pos;
+        auto& child = get_child(child_pos->second);
+        if (&child != target) {
+          co_return;
+        }
 
         co_await child.mutex_.lock();
         mutex_guard guard_child{child.mutex_, std::adopt_lock};
@@ -434,25 +1442,25 @@ namespace detail {
         co_await activate_segment(next_pos);
       }
       else {
-        if constexpr (tag_traits<level_tag_type>::is_static) {
+        if constexpr (is_static) {
           if constexpr (!tag_traits<level_tag_type>::is_root) {
             co_await clean_parent(std::move(guard_parent),
                                   std::move(guard_this));
           }
           else {
             if (interrupted_) {
-              co_await runque_->interrupt();
+              co_await detail::runque_interrupt(*runque_);
             }
           }
         }
         else {
-          if (tag_.size() != 0) {
+          if (depth() != 0) {
             co_await clean_parent(std::move(guard_parent),
                                   std::move(guard_this));
           }
           else {
             if (interrupted_) {
-              co_await runque_->interrupt();
+              co_await detail::runque_interrupt(*runque_);
             }
           }
         }
@@ -460,30 +1468,97 @@ namespace detail {
     }
 
     task<> clean_parent(mutex_guard&& guard_parent, mutex_guard&& guard_this) {
-      auto parent = parent_;
+      auto parent = parent_.load(std::memory_order_relaxed);
 
       auto version = get_version();
-      auto tag = tag_;
+      auto key = get_key();
 
       sink(guard_parent);
       sink(guard_this);
 
-      co_await parent->remove_child(tag, version);
+      co_await parent->remove_child(key, this, version);
+    }
+
+    task<prev_type*> lock_with_parent() {
+      while (true) {
+        auto parent = parent_.load(std::memory_order_relaxed);
+
+        co_await parent->mutex_.lock();
+        co_await mutex_.lock();
+
+        if (parent == parent_.load(std::memory_order_relaxed)) {
+          co_return parent;
+        }
+
+        mutex_.unlock();
+        parent->mutex_.unlock();
+      }
     }
 
     inline std::uint64_t get_version() {
       return segments_.front().version_;
     }
 
+    inline auto get_key() const {
+      if constexpr (is_static) {
+        return tag_.key();
+      }
+      else {
+        return tag_.values()[base_];
+      }
+    }
+
+    inline size_type depth() const noexcept {
+      return tag_.size();
+    }
+
+    inline bool empty() const noexcept {
+      return segments_.size() == 1 && segments_.front().empty();
+    }
+
+    static inline next_type& get_child(child_holder& holder) noexcept {
+      if constexpr (is_static) {
+        return holder;
+      }
+      else {
+        return *holder;
+      }
+    }
+
     inline auto make_handle(segment_iter segment_pos,
                             sibling_iter sibling_pos) {
       using alloc_type =
           detail::rebind_alloc_t<allocator_type, item_handle_impl>;
-      return std::allocate_shared<item_handle_impl>(
+      auto handle = std::allocate_shared<item_handle_impl>(
           alloc_type{segments_.get_allocator()},
           sibling_pos,
           segment_pos,
           *this);
+
+      handle->sequence_ = sibling_pos->sequence_;
+      if constexpr (is_inheriting) {
+        handle->hook_.priority_ = sibling_pos->priority_;
+      }
+
+      return handle;
+    }
+
+    inline auto make_range_handle(segment_iter segment_pos,
+                                  children_iter range_pos) {
+      using alloc_type =
+          detail::rebind_alloc_t<allocator_type, range_handle_impl>;
+      auto handle = std::allocate_shared<range_handle_impl>(
+          alloc_type{segments_.get_allocator()},
+          range_pos,
+          segment_pos,
+          *this);
+
+      handle->sequence_ = range_pos->payload_.sequence_;
+      if constexpr (is_inheriting) {
+        handle->hook_.priority_ = range_pos->payload_.priority_;
+      }
+
+      return handle;
     }
 
   private:
@@ -491,9 +1566,11 @@ namespace detail {
 
     runque_type* runque_;
 
-    prev_type* parent_;
+    std::atomic<prev_type*> parent_;
 
     level_tag_type tag_;
+    size_type base_;
+
     segment_list segments_;
 
     bool interrupted_{false};
@@ -561,14 +1638,132 @@ public:
     co_await root_.reserve(view(tag), std::move(value));
   }
 
-  task<retainment_type> get() noexcept {
+  template<taglike Target>
+  task<reservation_type> reserve(Target const& tag, item_priority priority) {
+    co_return co_await root_.reserve(view(tag), std::nullopt, priority);
+  }
+
+  template<taglike Target>
+  task<> reserve(Target const& tag,
+                 value_type const& value,
+                 item_priority priority) {
+    co_await root_.reserve(view(tag), value, priority);
+  }
+
+  template<taglike Target>
+  task<> reserve(Target const& tag,
+                 value_type&& value,
+                 item_priority priority) {
+    co_await root_.reserve(view(tag), std::move(value), priority);
+  }
+
+  template<taglike Target>
+  task<std::optional<reservation_type>>
+      reserve_until(Target const& tag,
+                    timer_wheel::time_point deadline,
+                    timer_wheel& timers = default_timer_wheel()) {
+    co_return co_await root_.reserve_until(
+        view(tag), std::nullopt, deadline, timers);
+  }
+
+  template<taglike Target>
+  task<bool> reserve_until(Target const& tag,
+                           value_type const& value,
+                           timer_wheel::time_point deadline,
+                           timer_wheel& timers = default_timer_wheel()) {
+    auto reserved =
+        co_await root_.reserve_until(view(tag), value, deadline, timers);
+    co_return reserved.has_value();
+  }
+
+  template<taglike Target>
+  task<bool> reserve_until(Target const& tag,
+                           value_type&& value,
+                           timer_wheel::time_point deadline,
+                           timer_wheel& timers = default_timer_wheel()) {
+    auto reserved = co_await root_.reserve_until(
+        view(tag), std::move(value), deadline, timers);
+    co_return reserved.has_value();
+  }
+
+  template<taglike Target, typename Rep, typename Period>
+  inline task<std::optional<reservation_type>>
+      reserve_for(Target const& tag,
+                  std::chrono::duration<Rep, Period> const& timeout,
+                  timer_wheel& timers = default_timer_wheel()) {
+    return reserve_until(tag, deadline_after(timeout), timers);
+  }
+
+  template<taglike Target, typename Rep, typename Period>
+  inline task<bool>
+      reserve_for(Target const& tag,
+                  value_type const& value,
+                  std::chrono::duration<Rep, Period> const& timeout,
+                  timer_wheel& timers = default_timer_wheel()) {
+    return reserve_until(tag, value, deadline_after(timeout), timers);
+  }
+
+  template<taglike Target, typename Rep, typename Period>
+  inline task<bool>
+      reserve_for(Target const& tag,
+                  value_type&& value,
+                  std::chrono::duration<Rep, Period> const& timeout,
+                  timer_wheel& timers = default_timer_wheel()) {
+    return reserve_until(
+        tag, std::move(value), deadline_after(timeout), timers);
+  }
+
+  typename runque_type::get_type
+      get() noexcept(detail::awaitable_runque<runque_type>) {
     return runque_.get();
   }
 
+  task<retainment_type> get(executor_ref exec) noexcept
+      requires(executor_runlike<runque_type>) {
+    return runque_.get(exec);
+  }
+
+  task<retainment_type> get(std::stop_token stop) noexcept
+      requires(cancellable_runlike<runque_type>) {
+    return runque_.get(std::move(stop));
+  }
+
+  std::optional<retainment_type> try_get() requires(
+      pollable_runlike<runque_type>) {
+    return runque_.try_get();
+  }
+
+  task<std::optional<retainment_type>>
+      get_until(timer_wheel::time_point deadline,
+                timer_wheel& timers = default_timer_wheel()) requires(
+          timed_runlike<runque_type>) {
+    return runque_.get_until(deadline, timers);
+  }
+
+  template<typename Rep, typename Period>
+  task<std::optional<retainment_type>>
+      get_for(std::chrono::duration<Rep, Period> const& timeout,
+              timer_wheel& timers = default_timer_wheel()) requires(
+          timed_runlike<runque_type>) {
+    return runque_.get_until(deadline_after(timeout), timers);
+  }
+
   task<> interrupt() noexcept {
     return root_.interrupt();
   }
 
+  inline runque_type& get_runque() noexcept {
+    return runque_;
+  }
+
+private:
+  template<typename Rep, typename Period>
+  static inline timer_wheel::time_point
+      deadline_after(std::chrono::duration<Rep, Period> const& timeout) {
+    return timer_wheel::clock_type::now() +
+           std::chrono::duration_cast<timer_wheel::duration>(timeout);
+  }
+
 private:
   runque_type runque_;
   root_chain_type meta_;
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "tag.hpp"
+#include "utility.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace frq {
+namespace detail {
+  template<typename Ty, typename Payload>
+  struct interval_node {
+    using range_type = interval<Ty>;
+    using payload_type = Payload;
+
+    template<typename... Tys>
+    inline interval_node(range_type const& range,
+                         std::uint64_t order,
+                         Tys&&... args)
+        : range_{range}
+        , max_{range.upper()}
+        , order_{order}
+        , payload_{std::forward<Tys>(args)...} {
+    }
+
+    range_type range_;
+    Ty max_;
+
+    std::uint64_t order_;
+
+    interval_node* left_{nullptr};
+    interval_node* right_{nullptr};
+
+    payload_type payload_;
+  };
+
+  template<typename Ty,
+           typename Payload,
+           typename Alloc = std::allocator<interval_node<Ty, Payload>>>
+  class interval_tree {
+  public:
+    using node_type = interval_node<Ty, Payload>;
+    using range_type = typename node_type::range_type;
+    using allocator_type = rebind_alloc_t<Alloc, node_type>;
+    using iterator = node_type*;
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+  public:
+    inline interval_tree() noexcept = default;
+
+    explicit inline interval_tree(allocator_type const& alloc) noexcept
+        : alloc_{alloc} {
+    }
+
+    inline interval_tree(interval_tree&& other) noexcept
+        : alloc_{other.alloc_}
+        , root_{std::exchange(other.root_, nullptr)}
+        , next_order_{other.next_order_} {
+    }
+
+    interval_tree(interval_tree const&) = delete;
+
+    interval_tree& operator=(interval_tree&&) = delete;
+    interval_tree& operator=(interval_tree const&) = delete;
+
+    inline ~interval_tree() {
+      destroy(root_);
+    }
+
+    template<typename... Tys>
+    node_type* insert(range_type const& range, Tys&&... args) {
+      auto node = alloc_traits::allocate(alloc_, 1);
+      try {
+        alloc_traits::construct(
+            alloc_, node, range, next_order_, std::forward<Tys>(args)...);
+      }
+      catch (...) {
+        alloc_traits::deallocate(alloc_, node, 1);
+        throw;
+      }
+
+      ++next_order_;
+      root_ = insert(root_, node);
+
+      return node;
+    }
+
+    void erase(node_type* node) noexcept {
+      root_ = erase(root_, node);
+
+      alloc_traits::destroy(alloc_, node);
+      alloc_traits::deallocate(alloc_, node, 1);
+    }
+
+    template<typename Fn>
+    inline void overlaps(range_type const& range, Fn&& fn) {
+      overlaps(root_, range, fn);
+    }
+
+    template<typename Fn>
+    inline void for_each(Fn&& fn) {
+      for_each(root_, fn);
+    }
+
+    inline bool empty() const noexcept {
+      return root_ == nullptr;
+    }
+
+  private:
+    static inline std::uint64_t weight(node_type const* node) noexcept {
+      auto value = node->order_ + 0x9e3779b97f4a7c15ULL;
+      value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+      value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+      return value ^ (value >> 31U);
+    }
+
+    static inline bool before(node_type const* left,
+                              node_type const* right) noexcept {
+      return left->range_.lower() < right->range_.lower() ||
+             (!(right->range_.lower() < left->range_.lower()) &&
+              left->order_ < right->order_);
+    }
+
+    static inline void update(node_type* node) noexcept {
+      node->max_ = node->range_.upper();
+      if (node->left_ != nullptr && node->max_ < node->left_->max_) {
+        node->max_ = node->left_->max_;
+      }
+
+      if (node->right_ != nullptr && node->max_ < node->right_->max_) {
+        node->max_ = node->right_->max_;
+      }
+    }
+
+    static node_type* rotate_right(node_type* node) noexcept {
+      auto top = node->left_;
+      node->left_ = top->right_;
+      top->right_ = node;
+
+      update(node);
+      update(top);
+
+      return top;
+    }
+
+    static node_type* rotate_left(node_type* node) noexcept {
+      auto top = node->right_;
+      node->right_ = top->left_;
+      top->left_ = node;
+
+      update(node);
+      update(top);
+
+      return top;
+    }
+
+    static node_type* insert(node_type* root, node_type* node) noexcept {
+      if (root == nullptr) {
+        return node;
+      }
+
+      if (before(node, root)) {
+        root->left_ = insert(root->left_, node);
+        if (weight(root) < weight(root->left_)) {
+          return rotate_right(root);
+        }
+      }
+      else {
+        root->right_ = insert(root->right_, node);
+        if (weight(root) < weight(root->right_)) {
+          return rotate_left(root);
+        }
+      }
+
+      update(root);
+      return root;
+    }
+
+    static node_type* merge(node_type* left, node_type* right) noexcept {
+      if (left == nullptr) {
+        return right;
+      }
+
+      if (right == nullptr) {
+        return left;
+      }
+
+      if (weight(right) < weight(left)) {
+        left->right_ = merge(left->right_, right);
+        update(left);
+        return left;
+      }
+
+      right->left_ = merge(left, right->left_);
+      update(right);
+      return right;
+    }
+
+    static node_type* erase(node_type* root, node_type* node) noexcept {
+      assert(root != nullptr);
+
+      if (root == node) {
+        return merge(root->left_, root->right_);
+      }
+
+      if (before(node, root)) {
+        root->left_ = erase(root->left_, node);
+      }
+      else {
+        root->right_ = erase(root->right_, node);
+      }
+
+      update(root);
+      return root;
+    }
+
+    template<typename Fn>
+    static void overlaps(node_type* node, range_type const& range, Fn& fn) {
+      while (node != nullptr && range.lower() < node->max_) {
+        overlaps(node->left_, range, fn);
+
+        if (!(node->range_.lower() < range.upper())) {
+          return;
+        }
+
+        if (node->range_.overlaps(range)) {
+          fn(*node);
+        }
+
+        node = node->right_;
+      }
+    }
+
+    template<typename Fn>
+    static void for_each(node_type* node, Fn& fn) {
+      while (node != nullptr) {
+        for_each(node->left_, fn);
+        fn(*node);
+        node = node->right_;
+      }
+    }
+
+    void destroy(node_type* node) noexcept {
+      while (node != nullptr) {
+        destroy(node->left_);
+
+        auto right = node->right_;
+        alloc_traits::destroy(alloc_, node);
+        alloc_traits::deallocate(alloc_, node, 1);
+
+        node = right;
+      }
+    }
+
+  private:
+    [[no_unique_address]] allocator_type alloc_{};
+
+    node_type* root_{nullptr};
+    std::uint64_t next_order_{0};
+  };
+} // namespace detail
+} // namespace frq
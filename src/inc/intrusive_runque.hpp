@@ -0,0 +1,383 @@
+#pragma once
+
+#include "forque.hpp"
+#include "runque.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace frq {
+namespace detail {
+  template<typename Ty, typename Alloc>
+  class base_intrusive_queue {
+  public:
+    using value_type = retainment<Ty>;
+    using allocator_type = Alloc;
+
+    static constexpr bool is_intrusive = true;
+
+  protected:
+    using node_type = intrusive_handle<Ty>;
+
+  public:
+    explicit inline base_intrusive_queue(
+        allocator_type const& /*unused*/ = allocator_type{}) noexcept {
+    }
+
+    base_intrusive_queue(base_intrusive_queue const&) = delete;
+    base_intrusive_queue(base_intrusive_queue&&) = delete;
+
+    base_intrusive_queue& operator=(base_intrusive_queue const&) = delete;
+    base_intrusive_queue& operator=(base_intrusive_queue&&) = delete;
+
+    inline bool empty() const noexcept {
+      return head_ == nullptr;
+    }
+
+  protected:
+    inline ~base_intrusive_queue() = default;
+
+    static inline node_type* link(value_type&& value) noexcept {
+      return retainment_access::link(std::move(value));
+    }
+
+    static inline value_type unlink(node_type* node) noexcept {
+      return retainment_access::unlink(node);
+    }
+
+    static inline node_type*& next(node_type* node) noexcept {
+      return node->hook_.next_;
+    }
+
+    static inline node_type*& child(node_type* node) noexcept {
+      return node->hook_.child_;
+    }
+
+  protected:
+    node_type* head_{nullptr};
+  };
+} // namespace detail
+
+template<typename Ty, typename Alloc = std::allocator<retainment<Ty>>>
+class intrusive_fifo_queue : public detail::base_intrusive_queue<Ty, Alloc> {
+private:
+  using base_type = detail::base_intrusive_queue<Ty, Alloc>;
+
+public:
+  using typename base_type::allocator_type;
+  using typename base_type::value_type;
+
+  using base_type::base_type;
+
+  inline ~intrusive_fifo_queue() {
+    while (!this->empty()) {
+      static_cast<void>(pop());
+    }
+  }
+
+  inline void push(value_type&& value) noexcept {
+    auto node = base_type::link(std::move(value));
+
+    if (this->head_ == nullptr) {
+      this->head_ = node;
+    }
+    else {
+      base_type::next(tail_) = node;
+    }
+
+    tail_ = node;
+  }
+
+  inline value_type pop() noexcept {
+    auto node = std::exchange(this->head_, base_type::next(this->head_));
+    return base_type::unlink(node);
+  }
+
+private:
+  typename base_type::node_type* tail_{nullptr};
+};
+
+template<typename Ty, typename Alloc = std::allocator<retainment<Ty>>>
+class intrusive_lifo_queue : public detail::base_intrusive_queue<Ty, Alloc> {
+private:
+  using base_type = detail::base_intrusive_queue<Ty, Alloc>;
+
+public:
+  using typename base_type::allocator_type;
+  using typename base_type::value_type;
+
+  using base_type::base_type;
+
+  inline ~intrusive_lifo_queue() {
+    while (!this->empty()) {
+      static_cast<void>(pop());
+    }
+  }
+
+  inline void push(value_type&& value) noexcept {
+    auto node = base_type::link(std::move(value));
+
+    base_type::next(node) = this->head_;
+    this->head_ = node;
+  }
+
+  inline value_type pop() noexcept {
+    auto node = std::exchange(this->head_, base_type::next(this->head_));
+    return base_type::unlink(node);
+  }
+};
+
+template<typename Ty,
+         typename Alloc = std::allocator<retainment<Ty>>,
+         typename Less = std::less<Ty>>
+class intrusive_priority_queue
+    : public detail::base_intrusive_queue<Ty, Alloc> {
+private:
+  using base_type = detail::base_intrusive_queue<Ty, Alloc>;
+  using node_type = typename base_type::node_type;
+
+public:
+  using typename base_type::allocator_type;
+  using typename base_type::value_type;
+
+  using base_type::base_type;
+
+  inline ~intrusive_priority_queue() {
+    while (!this->empty()) {
+      static_cast<void>(pop());
+    }
+  }
+
+  inline void push(value_type&& value) noexcept {
+    this->head_ = merge(this->head_, base_type::link(std::move(value)));
+  }
+
+  inline value_type pop() noexcept {
+    auto node = this->head_;
+    this->head_ = combine(base_type::child(node));
+
+    return base_type::unlink(node);
+  }
+
+private:
+  static inline bool less(node_type* left, node_type* right) noexcept {
+    return Less{}(left->value(), right->value());
+  }
+
+  static node_type* merge(node_type* left, node_type* right) noexcept {
+    if (left == nullptr) {
+      return right;
+    }
+
+    if (right == nullptr) {
+      return left;
+    }
+
+    if (less(left, right)) {
+      std::swap(left, right);
+    }
+
+    base_type::next(right) = base_type::child(left);
+    base_type::child(left) = right;
+
+    return left;
+  }
+
+  static node_type* combine(node_type* first) noexcept {
+    node_type* pairs{nullptr};
+    while (first != nullptr) {
+      auto left = first;
+      auto right = base_type::next(left);
+
+      first = right != nullptr ? base_type::next(right) : nullptr;
+
+      base_type::next(left) = nullptr;
+      if (right != nullptr) {
+        base_type::next(right) = nullptr;
+      }
+
+      auto merged = merge(left, right);
+      base_type::next(merged) = pairs;
+      pairs = merged;
+    }
+
+    node_type* root{nullptr};
+    while (pairs != nullptr) {
+      auto next = std::exchange(base_type::next(pairs), nullptr);
+      root = merge(root, pairs);
+      pairs = next;
+    }
+
+    return root;
+  }
+};
+
+template<typename Ty, typename Alloc = std::allocator<retainment<Ty>>>
+class inherited_priority_queue {
+public:
+  using value_type = retainment<Ty>;
+  using allocator_type = Alloc;
+
+  static constexpr bool is_intrusive = true;
+  static constexpr bool is_inheriting = true;
+
+private:
+  using node_type = detail::intrusive_handle<Ty>;
+  using node_alloc_type = detail::rebind_alloc_t<allocator_type, node_type*>;
+  using heap_type = std::vector<node_type*, node_alloc_type>;
+
+public:
+  explicit inline inherited_priority_queue(
+      allocator_type const& alloc = allocator_type{})
+      : heap_{alloc} {
+  }
+
+  inherited_priority_queue(inherited_priority_queue const&) = delete;
+  inherited_priority_queue(inherited_priority_queue&&) = delete;
+
+  inherited_priority_queue& operator=(inherited_priority_queue const&) = delete;
+  inherited_priority_queue& operator=(inherited_priority_queue&&) = delete;
+
+  inline ~inherited_priority_queue() {
+    while (!empty()) {
+      static_cast<void>(pop());
+    }
+  }
+
+  void push(value_type&& value) {
+    heap_.push_back(nullptr);
+
+    auto node = detail::retainment_access::link(std::move(value));
+    node->hook_.order_ = next_order_++;
+
+    sift_up(heap_.size() - 1, node);
+  }
+
+  value_type pop() noexcept {
+    auto node = heap_.front();
+
+    auto last = heap_.back();
+    heap_.pop_back();
+
+    if (!heap_.empty()) {
+      sift_down(0, last);
+    }
+
+    node->hook_.index_ = 0;
+    return detail::retainment_access::unlink(node);
+  }
+
+  void boost(detail::item_handle<Ty>* handle, std::int64_t priority) noexcept {
+    auto node = static_cast<node_type*>(handle);
+    if (node->hook_.priority_ < priority) {
+      node->hook_.priority_ = priority;
+      if (node->hook_.index_ != 0) {
+        sift_up(node->hook_.index_ - 1, node);
+      }
+    }
+  }
+
+  inline bool empty() const noexcept {
+    return heap_.empty();
+  }
+
+  inline std::size_t size() const noexcept {
+    return heap_.size();
+  }
+
+private:
+  static inline bool before(node_type* left, node_type* right) noexcept {
+    return left->hook_.priority_ > right->hook_.priority_ ||
+           (left->hook_.priority_ == right->hook_.priority_ &&
+            left->hook_.order_ < right->hook_.order_);
+  }
+
+  inline void place(std::size_t index, node_type* node) noexcept {
+    heap_[index] = node;
+    node->hook_.index_ = index + 1;
+  }
+
+  void sift_up(std::size_t index, node_type* node) noexcept {
+    while (index != 0) {
+      auto parent = (index - 1) / 2;
+      if (!before(node, heap_[parent])) {
+        break;
+      }
+
+      place(index, heap_[parent]);
+      index = parent;
+    }
+
+    place(index, node);
+  }
+
+  void sift_down(std::size_t index, node_type* node) noexcept {
+    auto size = heap_.size();
+    for (;;) {
+      auto child = index * 2 + 1;
+      if (child >= size) {
+        break;
+      }
+
+      if (child + 1 < size && before(heap_[child + 1], heap_[child])) {
+        ++child;
+      }
+
+      if (!before(heap_[child], node)) {
+        break;
+      }
+
+      place(index, heap_[child]);
+      index = child;
+    }
+
+    place(index, node);
+  }
+
+private:
+  heap_type heap_;
+  std::uint64_t next_order_{0};
+};
+
+struct intrusive_fifo_order {};
+struct intrusive_lifo_order {};
+struct intrusive_priority_order {};
+struct inherited_priority_order {};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<intrusive_fifo_order, Mtm, retainment<Ty>, Alloc> {
+  using type = runque<intrusive_fifo_queue<Ty, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<intrusive_lifo_order, Mtm, retainment<Ty>, Alloc> {
+  using type = runque<intrusive_lifo_queue<Ty, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Less>
+struct make_runque<intrusive_priority_order,
+                   Mtm,
+                   retainment<Ty>,
+                   Alloc,
+                   Less> {
+  using type = runque<intrusive_priority_queue<Ty, Alloc, Less>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<intrusive_priority_order, Mtm, retainment<Ty>, Alloc>
+    : make_runque<intrusive_priority_order,
+                  Mtm,
+                  retainment<Ty>,
+                  Alloc,
+                  std::less<Ty>> {};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<inherited_priority_order, Mtm, retainment<Ty>, Alloc> {
+  using type = runque<inherited_priority_queue<Ty, Alloc>, Mtm>;
+};
+
+} // namespace frq
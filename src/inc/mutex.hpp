@@ -1,7 +1,10 @@
 #pragma once
 
+#include "timer_wheel.hpp"
+
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <coroutine>
 #include <mutex>
 
@@ -11,6 +14,47 @@ namespace detail {
   struct mxwait {
     std::coroutine_handle<> waiter_;
     mxwait* next_{nullptr};
+    bool (*grant_)(mxwait&){nullptr};
+  };
+
+  class mxtimed : public mxwait {
+  public:
+    mxtimed(std::coroutine_handle<> waiter, timer_wheel& timers) noexcept;
+
+    mxtimed(mxtimed const&) = delete;
+    mxtimed(mxtimed&&) = delete;
+
+    mxtimed& operator=(mxtimed const&) = delete;
+    mxtimed& operator=(mxtimed&&) = delete;
+
+    ~mxtimed() = default;
+
+    bool arrive() noexcept;
+    void drop() noexcept;
+
+    inline bool granted() const noexcept {
+      return status_.load(std::memory_order_acquire) == granted_status;
+    }
+
+    inline timer_entry& entry() noexcept {
+      return entry_;
+    }
+
+  private:
+    static constexpr int waiting_status = 0;
+    static constexpr int granted_status = 1;
+    static constexpr int expired_status = 2;
+
+    static bool grant(mxwait& entry) noexcept;
+    static void expire(void* context) noexcept;
+
+  private:
+    std::atomic<int> status_{waiting_status};
+    std::atomic<int> arrivals_{0};
+    std::atomic<int> refs_{2};
+
+    timer_wheel* timers_;
+    timer_entry entry_;
   };
 
   class mxstate {
@@ -111,6 +155,29 @@ public:
     [[nodiscard]] mutex_guard await_resume() noexcept;
   };
 
+  class timed_awaitable {
+  public:
+    inline timed_awaitable(detail::mximpl& impl,
+                           timer_wheel::time_point deadline,
+                           timer_wheel& timers) noexcept
+        : impl_{&impl}
+        , timers_{&timers}
+        , deadline_{deadline} {
+    }
+
+    bool await_ready() noexcept;
+    bool await_suspend(std::coroutine_handle<> handle);
+    [[nodiscard]] bool await_resume() noexcept;
+
+  private:
+    detail::mximpl* impl_;
+    timer_wheel* timers_;
+    timer_wheel::time_point deadline_;
+
+    detail::mxtimed* node_{nullptr};
+    bool acquired_{false};
+  };
+
 public:
   mutex() = default;
 
@@ -130,6 +197,22 @@ public:
     return scoped_awaitable{impl_};
   }
 
+  [[nodiscard]] inline timed_awaitable
+      lock_until(timer_wheel::time_point deadline,
+                 timer_wheel& timers = default_timer_wheel()) noexcept {
+    return timed_awaitable{impl_, deadline, timers};
+  }
+
+  template<typename Rep, typename Period>
+  [[nodiscard]] inline timed_awaitable
+      lock_for(std::chrono::duration<Rep, Period> const& timeout,
+               timer_wheel& timers = default_timer_wheel()) noexcept {
+    return lock_until(
+        timer_wheel::clock_type::now() +
+            std::chrono::duration_cast<timer_wheel::duration>(timeout),
+        timers);
+  }
+
   [[nodiscard]] inline bool try_lock() noexcept {
     return impl_.try_lock();
   }
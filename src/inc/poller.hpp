@@ -0,0 +1,79 @@
+#pragma once
+
+#include "utility.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace frq {
+
+template<typename Ty>
+concept pollable = requires(Ty& source) {
+  { source.try_get().has_value() }
+  ->std::convertible_to<bool>;
+};
+
+template<pollable... Sources>
+class poller {
+public:
+  static constexpr std::size_t size = sizeof...(Sources);
+
+  static_assert(size != 0);
+
+public:
+  explicit inline poller(Sources&... sources) noexcept
+      : sources_{std::addressof(sources)...} {
+  }
+
+  template<typename Fn>
+  bool poll(Fn&& fn) {
+    for (std::size_t i = 0; i < size; ++i) {
+      auto index = (next_ + i) % size;
+      if (poll_source(index, fn)) {
+        next_ = index + 1;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  template<typename Fn, typename Stop>
+  void run(Fn&& fn, Stop&& stop) {
+    while (!stop()) {
+      if (!poll(fn)) {
+        detail::cpu_relax();
+      }
+    }
+  }
+
+private:
+  template<typename Fn>
+  inline bool poll_source(std::size_t index, Fn& fn) {
+    return [this, index, &fn]<std::size_t... Is>(
+               std::index_sequence<Is...> /*unused*/) {
+      return ((Is == index && poll_at<Is>(fn)) || ...);
+    }(std::index_sequence_for<Sources...>{});
+  }
+
+  template<std::size_t Index, typename Fn>
+  inline bool poll_at(Fn& fn) {
+    auto item = std::get<Index>(sources_)->try_get();
+    if (!item) {
+      return false;
+    }
+
+    fn(std::move(*item));
+    return true;
+  }
+
+private:
+  std::tuple<Sources*...> sources_;
+  std::size_t next_{0};
+};
+
+} // namespace frq
@@ -0,0 +1,385 @@
+#pragma once
+
+#include "executor.hpp"
+#include "runque.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace frq {
+namespace detail {
+  template<typename Clock>
+  struct token_bucket {
+    using time_point = typename Clock::time_point;
+
+    inline time_point acquire(time_point now) noexcept {
+      std::chrono::duration<double> elapsed{now - updated_};
+      if (elapsed.count() > 0) {
+        tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+        updated_ = now;
+      }
+
+      tokens_ -= 1;
+      if (tokens_ >= 0) {
+        return now;
+      }
+
+      return now + std::chrono::duration_cast<typename Clock::duration>(
+                       std::chrono::duration<double>{-tokens_ / rate_});
+    }
+
+    double rate_;
+    double burst_;
+    double tokens_;
+    time_point updated_;
+  };
+
+  template<typename Ty, typename Clock>
+  struct held_item {
+    typename Clock::time_point ready_;
+    std::uint64_t order_;
+    Ty value_;
+  };
+
+  struct held_later {
+    template<typename Ty>
+    inline bool operator()(Ty const& left, Ty const& right) const noexcept {
+      return left.ready_ > right.ready_ ||
+             (left.ready_ == right.ready_ && left.order_ > right.order_);
+    }
+  };
+} // namespace detail
+
+template<runlike Runque,
+         typename Key,
+         typename Clock = std::chrono::steady_clock,
+         typename Alloc = std::allocator<typename Runque::value_type>>
+class rate_limited_runque {
+public:
+  using runque_type = Runque;
+  using value_type = typename runque_type::value_type;
+  using get_type = typename runque_type::get_type;
+  using allocator_type = Alloc;
+
+  using key_type = std::decay_t<decltype(detail::invoke_on_item<Key>(
+      std::declval<value_type const&>()))>;
+
+  using clock_type = Clock;
+  using time_point = typename clock_type::time_point;
+
+private:
+  using bucket_type = detail::token_bucket<clock_type>;
+  using held_type = detail::held_item<value_type, clock_type>;
+
+  using bucket_map = std::unordered_map<
+      key_type,
+      bucket_type,
+      std::hash<key_type>,
+      std::equal_to<key_type>,
+      detail::rebind_alloc_t<allocator_type,
+                             std::pair<const key_type, bucket_type>>>;
+
+  using held_list =
+      std::vector<held_type, detail::rebind_alloc_t<allocator_type, held_type>>;
+
+public:
+  // released items are put into the inner runque from a dispatch executor,
+  // so the consumers they wake never run on the limiter thread; without one
+  // the runque starts its own dispatch thread along with the limiter
+  explicit inline rate_limited_runque(
+      allocator_type const& alloc = allocator_type{})
+      : buckets_{alloc}
+      , held_{alloc} {
+  }
+
+  explicit inline rate_limited_runque(
+      executor_ref dispatch,
+      allocator_type const& alloc = allocator_type{})
+      : dispatch_{dispatch}
+      , buckets_{alloc}
+      , held_{alloc} {
+  }
+
+  rate_limited_runque(rate_limited_runque const&) = delete;
+  rate_limited_runque(rate_limited_runque&&) = delete;
+
+  rate_limited_runque& operator=(rate_limited_runque const&) = delete;
+  rate_limited_runque& operator=(rate_limited_runque&&) = delete;
+
+  inline ~rate_limited_runque() {
+    {
+      std::lock_guard guard{lock_};
+      stopped_ = true;
+    }
+
+    cond_.notify_all();
+    if (timer_.joinable()) {
+      timer_.join();
+    }
+
+    std::unique_lock lock{lock_};
+    cond_.wait(lock, [this] { return releasing_ == 0; });
+  }
+
+  void set_rate(key_type const& key, double rate, double burst) {
+    assert(rate > 0 && burst >= 1);
+
+    std::lock_guard guard{lock_};
+    buckets_.insert_or_assign(
+        key, bucket_type{rate, burst, burst, clock_type::now()});
+  }
+
+  void clear_rate(key_type const& key) {
+    std::lock_guard guard{lock_};
+    buckets_.erase(key);
+  }
+
+  inline get_type get() {
+    return inner_.get();
+  }
+
+  inline get_type get(executor_ref exec) requires(
+      executor_runlike<runque_type>) {
+    return inner_.get(exec);
+  }
+
+  inline get_type get(std::stop_token stop) requires(
+      cancellable_runlike<runque_type>) {
+    return inner_.get(std::move(stop));
+  }
+
+  inline std::optional<value_type> try_get() requires(
+      pollable_runlike<runque_type>) {
+    return inner_.try_get();
+  }
+
+  inline task<std::optional<value_type>>
+      get_until(timer_wheel::time_point deadline,
+                timer_wheel& timers = default_timer_wheel()) requires(
+          timed_runlike<runque_type>) {
+    return inner_.get_until(deadline, timers);
+  }
+
+  template<typename Rep, typename Period>
+  inline task<std::optional<value_type>>
+      get_for(std::chrono::duration<Rep, Period> const& timeout,
+              timer_wheel& timers = default_timer_wheel()) requires(
+          timed_runlike<runque_type>) {
+    return inner_.get_for(timeout, timers);
+  }
+
+  task<> put(value_type&& value) {
+    {
+      std::lock_guard guard{lock_};
+      if (stopped_) {
+        throw interrupted{};
+      }
+
+      auto pos =
+          buckets_.find(detail::invoke_on_item<Key>(std::as_const(value)));
+      if (pos != buckets_.end()) {
+        auto now = clock_type::now();
+        if (auto ready = pos->second.acquire(now); now < ready) {
+          hold(ready, std::move(value));
+          co_return;
+        }
+      }
+    }
+
+    co_await inner_.put(std::move(value));
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline task<> put(
+      Tys&&... args) {
+    co_await put(value_type{std::forward<Tys>(args)...});
+  }
+
+  task<> put_many(std::span<value_type> values) {
+    std::size_t passed{0};
+
+    {
+      std::lock_guard guard{lock_};
+      if (stopped_) {
+        throw interrupted{};
+      }
+
+      auto now = clock_type::now();
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        auto& value = values[i];
+
+        auto pos =
+            buckets_.find(detail::invoke_on_item<Key>(std::as_const(value)));
+        if (pos != buckets_.end()) {
+          if (auto ready = pos->second.acquire(now); now < ready) {
+            hold(ready, std::move(value));
+            continue;
+          }
+        }
+
+        if (passed != i) {
+          values[passed] = std::move(value);
+        }
+
+        ++passed;
+      }
+    }
+
+    if constexpr (batch_runlike<runque_type>) {
+      co_await inner_.put_many(values.first(passed));
+    }
+    else {
+      for (auto& value : values.first(passed)) {
+        co_await inner_.put(std::move(value));
+      }
+    }
+  }
+
+  // items still held are forwarded ahead of the interrupt, so they share
+  // the fate of the items already queued in the inner runque
+  inline task<> interrupt() noexcept {
+    held_list held{held_.get_allocator()};
+
+    {
+      std::lock_guard guard{lock_};
+      stopped_ = true;
+      held.swap(held_);
+    }
+
+    cond_.notify_all();
+
+    std::sort_heap(held.begin(), held.end(), detail::held_later{});
+    for (auto item = held.rbegin(); item != held.rend(); ++item) {
+      try {
+        co_await inner_.put(std::move(item->value_));
+      }
+      catch (...) {
+        std::lock_guard guard{lock_};
+        ++dropped_;
+      }
+    }
+
+    co_await inner_.interrupt();
+  }
+
+  inline std::size_t held() const noexcept {
+    std::lock_guard guard{lock_};
+    return held_.size();
+  }
+
+  // items that were held and then failed to reach the inner runque
+  inline std::size_t dropped() const noexcept {
+    std::lock_guard guard{lock_};
+    return dropped_;
+  }
+
+  inline runque_type& get_runque() noexcept {
+    return inner_;
+  }
+
+private:
+  void hold(time_point ready, value_type&& value) {
+    held_.push_back(held_type{ready, order_++, std::move(value)});
+    std::push_heap(held_.begin(), held_.end(), detail::held_later{});
+
+    if (!timer_.joinable()) {
+      if (!dispatch_) {
+        owned_dispatch_ = std::make_unique<thread_executor>();
+        dispatch_.emplace(*owned_dispatch_);
+      }
+
+      timer_ = std::thread{[this] { run(); }};
+    }
+    else if (held_.front().order_ + 1 == order_) {
+      cond_.notify_one();
+    }
+  }
+
+  void run() {
+    std::unique_lock lock{lock_};
+    while (!stopped_) {
+      if (held_.empty()) {
+        cond_.wait(lock);
+        continue;
+      }
+
+      if (auto ready = held_.front().ready_; clock_type::now() < ready) {
+        cond_.wait_until(lock, ready);
+        continue;
+      }
+
+      std::pop_heap(held_.begin(), held_.end(), detail::held_later{});
+
+      auto value{std::move(held_.back().value_)};
+      held_.pop_back();
+
+      ++releasing_;
+      lock.unlock();
+
+      try {
+        release(std::move(value)).post(*dispatch_);
+        lock.lock();
+      }
+      catch (...) {
+        lock.lock();
+
+        --releasing_;
+        ++dropped_;
+      }
+    }
+  }
+
+  detail::detached_task release(value_type value) {
+    auto forwarded{true};
+    try {
+      co_await inner_.put(std::move(value));
+    }
+    catch (...) {
+      forwarded = false;
+    }
+
+    std::lock_guard guard{lock_};
+    if (!forwarded) {
+      ++dropped_;
+    }
+
+    --releasing_;
+    cond_.notify_all();
+  }
+
+private:
+  runque_type inner_;
+  std::optional<executor_ref> dispatch_;
+
+  mutable std::mutex lock_;
+  std::condition_variable cond_;
+
+  bucket_map buckets_;
+
+  held_list held_;
+  std::uint64_t order_{0};
+
+  std::size_t releasing_{0};
+  std::size_t dropped_{0};
+
+  bool stopped_{false};
+  std::thread timer_;
+
+  // destroyed first, so a release still unwinding finishes before the rest
+  std::unique_ptr<thread_executor> owned_dispatch_;
+};
+
+} // namespace frq
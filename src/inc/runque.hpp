@@ -1,17 +1,41 @@
 #pragma once
 
+#include "executor.hpp"
 #include "mutex.hpp"
 #include "task.hpp"
+#include "timer_wheel.hpp"
 #include "utility.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
 #include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
 #include <variant>
 
 #include <deque>
 #include <queue>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 namespace frq {
 template<typename Ty>
@@ -25,6 +49,13 @@ public:
   }
 };
 
+class cancelled : public std::exception {
+public:
+  const char* what() const noexcept override {
+    return "runqueue wait cancelled";
+  }
+};
+
 namespace detail {
   template<typename Queue, typename Alloc>
   class base_runque_queue {
@@ -94,344 +125,2850 @@ public:
   }
 };
 
-template<runnable Ty, typename Alloc = std::allocator<Ty>>
-class fifo_runque_queue
-    : public detail::base_runque_queue<std::queue<Ty, std::deque<Ty, Alloc>>,
-                                       Alloc> {
-private:
-  using base_type =
-      detail::base_runque_queue<std::queue<Ty, std::deque<Ty, Alloc>>, Alloc>;
-
+template<runnable Ty,
+         typename Key,
+         typename Alloc = std::allocator<Ty>,
+         typename Less = std::less<>>
+class keyed_priority_runque_queue {
 public:
-  using base_type::base_type;
+  using value_type = Ty;
+  using allocator_type = Alloc;
+  using key_type = std::decay_t<std::invoke_result_t<Key, value_type const&>>;
 
-  inline auto pop() noexcept {
-    typename base_type::popper p{this->queue_};
-    return std::move(p.q.front());
-  }
-};
+  static_assert(std::is_nothrow_move_constructible_v<key_type> &&
+                std::is_nothrow_move_assignable_v<key_type>);
 
-template<runnable Ty, typename Alloc = std::allocator<Ty>>
-class lifo_runque_queue
-    : public detail::base_runque_queue<std::stack<Ty, std::vector<Ty, Alloc>>,
-                                       Alloc> {
 private:
-  using base_type =
-      detail::base_runque_queue<std::stack<Ty, std::vector<Ty, Alloc>>, Alloc>;
+  static constexpr std::size_t arity = 4;
 
-public:
-  using base_type::base_type;
+  using key_list =
+      std::vector<key_type, detail::rebind_alloc_t<allocator_type, key_type>>;
+  using item_list = std::vector<value_type, allocator_type>;
 
-  inline auto pop() noexcept {
-    typename base_type::popper p{this->queue_};
-    return std::move(p.q.top());
+public:
+  explicit inline keyed_priority_runque_queue(
+      allocator_type const& alloc = allocator_type{})
+      : keys_{alloc}
+      , items_{alloc} {
   }
-};
 
-template<typename Ty>
-class runque_tratis {
-  using port_type = Ty;
+  keyed_priority_runque_queue(keyed_priority_runque_queue const&) = delete;
+  keyed_priority_runque_queue(keyed_priority_runque_queue&&) = delete;
 
-  using value_model = typename port_type::value_model;
-  using thread_model = typename port_type::thread_model;
-  using return_type = std::decay_t<decltype(std::declval<port_type>().get())>;
-};
+  keyed_priority_runque_queue&
+      operator=(keyed_priority_runque_queue const&) = delete;
+  keyed_priority_runque_queue&
+      operator=(keyed_priority_runque_queue&&) = delete;
 
-struct priority_order {};
-struct fifo_order {};
-struct lifo_order {};
+  void push(value_type&& value) {
+    keys_.push_back(Key{}(std::as_const(value)));
+    try {
+      items_.push_back(std::move(value));
+    }
+    catch (...) {
+      keys_.pop_back();
+      throw;
+    }
 
-struct single_thread_model {};
-struct multi_thread_model {};
-struct coro_thread_model {};
+    sift_up(items_.size() - 1);
+  }
 
-template<typename Ty>
-concept queuelike = requires(Ty q) {
-  typename Ty::value_type;
-  typename Ty::allocator_type;
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
+  }
 
-  requires runnable<typename Ty::value_type>;
+  value_type pop() noexcept {
+    auto result{std::move(items_.front())};
 
-  { q.pop() }
-  ->std::same_as<typename Ty::value_type>;
-  {q.push(std::declval<typename Ty::value_type&&>())};
-  { q.empty() }
-  ->std::same_as<bool>;
-};
+    auto last = items_.size() - 1;
+    if (last != 0) {
+      sift_down(std::move(keys_[last]), std::move(items_[last]));
+    }
 
-template<typename Ty>
-concept runlike = requires(Ty s) {
-  typename Ty::value_type;
-  requires runnable<typename Ty::value_type>;
-  typename Ty::get_type;
+    keys_.pop_back();
+    items_.pop_back();
 
-  { s.get() }
-  ->std::same_as<typename Ty::get_type>;
-  {s.put(std::declval<typename Ty::value_type&&>())};
-};
+    return result;
+  }
 
-template<queuelike Queue, typename Mtm>
-class runque;
+  inline bool empty() const noexcept {
+    return items_.empty();
+  }
+
+  inline std::size_t size() const noexcept {
+    return items_.size();
+  }
 
-template<queuelike Queue>
-class runque<Queue, single_thread_model> {
 private:
-  using queue_type = Queue;
+  inline void move_slot(std::size_t to, std::size_t from) noexcept {
+    keys_[to] = std::move(keys_[from]);
+    items_[to] = std::move(items_[from]);
+  }
 
-public:
-  using thread_model = single_thread_model;
-  using value_type = typename queue_type::value_type;
-  using allocator_type = typename queue_type::allocator_type;
+  void sift_up(std::size_t hole) noexcept {
+    if (hole == 0) {
+      return;
+    }
 
-  using get_type = std::optional<value_type>;
+    auto key{std::move(keys_[hole])};
+    auto item{std::move(items_[hole])};
+    while (hole != 0) {
+      auto parent = (hole - 1) / arity;
+      if (!Less{}(keys_[parent], key)) {
+        break;
+      }
 
-public:
-  inline runque(allocator_type const& alloc = allocator_type{})
-      : items_{alloc} {
+      move_slot(hole, parent);
+      hole = parent;
+    }
+
+    keys_[hole] = std::move(key);
+    items_[hole] = std::move(item);
   }
 
-  runque(runque const&) = delete;
-  runque(runque&&) = delete;
+  void sift_down(key_type&& key, value_type&& item) noexcept {
+    auto size = items_.size() - 1;
 
-  runque& operator=(runque const&) = delete;
-  runque& operator=(runque&&) = delete;
+    std::size_t hole{0};
+    for (;;) {
+      auto first = hole * arity + 1;
+      if (first >= size) {
+        break;
+      }
 
-  inline get_type get() {
-    if (interrupted_) {
-      throw interrupted{};
-    }
+      auto best = first;
+      auto last = std::min(first + arity, size);
+      for (auto child = first + 1; child < last; ++child) {
+        if (Less{}(keys_[best], keys_[child])) {
+          best = child;
+        }
+      }
 
-    if (!items_.empty()) {
-      return items_.pop();
+      if (!Less{}(key, keys_[best])) {
+        break;
+      }
+
+      move_slot(hole, best);
+      hole = best;
     }
 
-    return {};
+    keys_[hole] = std::move(key);
+    items_[hole] = std::move(item);
   }
 
-  inline void put(value_type&& value) {
-    if (interrupted_) {
-      throw interrupted{};
-    }
+private:
+  key_list keys_;
+  item_list items_;
+};
 
-    items_.push(std::move(value));
+template<runnable Ty,
+         typename Priority,
+         typename Alloc = std::allocator<Ty>,
+         std::size_t Levels = 64>
+class bucket_priority_runque_queue {
+public:
+  static_assert(Levels != 0 && Levels <= 64);
+
+  using value_type = Ty;
+  using allocator_type = Alloc;
+
+private:
+  using bucket_type = std::deque<value_type, allocator_type>;
+
+public:
+  explicit inline bucket_priority_runque_queue(
+      allocator_type const& alloc = allocator_type{})
+      : buckets_{make_buckets(alloc, std::make_index_sequence<Levels>{})} {
   }
 
-  template<typename... Tys>
-  requires(std::is_constructible_v<value_type, Tys...>) inline void put(
-      Tys&&... args) {
-    if (interrupted_) {
-      throw interrupted{};
-    }
+  bucket_priority_runque_queue(bucket_priority_runque_queue const&) = delete;
+  bucket_priority_runque_queue(bucket_priority_runque_queue&&) = delete;
 
-    items_.push(std::forward<Tys>(args)...);
+  bucket_priority_runque_queue&
+      operator=(bucket_priority_runque_queue const&) = delete;
+  bucket_priority_runque_queue&
+      operator=(bucket_priority_runque_queue&&) = delete;
+
+  inline void push(value_type&& value) {
+    auto level = to_level(Priority{}(std::as_const(value)));
+
+    buckets_[level].push_back(std::move(value));
+    levels_ |= std::uint64_t{1} << level;
   }
 
-  inline void interrupt() noexcept {
-    interrupted_ = true;
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
   }
 
-private:
-  bool interrupted_{false};
-  queue_type items_;
-};
+  inline value_type pop() noexcept {
+    assert(levels_ != 0);
 
-namespace detail {
-  template<runnable Ty>
-  class runque_awaitable {
-  public:
-    using value_type = Ty;
+    auto level = 63 - std::countl_zero(levels_);
+    auto& bucket = buckets_[level];
 
-  public:
-    inline runque_awaitable(mutex& lock) noexcept
-        : guard_{lock, std::adopt_lock} {};
+    auto result{std::move(bucket.front())};
 
-    inline bool await_ready() noexcept {
-      return false;
+    bucket.pop_front();
+    if (bucket.empty()) {
+      levels_ &= ~(std::uint64_t{1} << level);
     }
 
-    inline void await_suspend(std::coroutine_handle<> waiter) noexcept {
-      waiter_ = waiter;
-      sink(guard_);
-    }
+    return result;
+  }
 
-    inline value_type& await_resume() & {
-      switch (result_.index()) {
-      case 1: std::rethrow_exception(std::get<1>(result_));
-      case 2: return std::get<2>(result_);
-      default: throw std::logic_error{"invalid coroutine result"};
-      }
-    }
+  inline bool empty() const noexcept {
+    return levels_ == 0;
+  }
 
-    inline runque_awaitable* set_next(runque_awaitable* next) noexcept {
-      next_ = next;
-      return this;
+private:
+  // priorities outside [0, Levels) saturate to the lowest or highest bucket
+  template<std::integral Level>
+  static inline std::size_t to_level(Level priority) noexcept {
+    if (std::cmp_less(priority, 0)) {
+      return 0;
     }
 
-    inline runque_awaitable* get_next() const noexcept {
-      return next_;
+    if (std::cmp_greater_equal(priority, Levels)) {
+      return Levels - 1;
     }
 
-    inline void resume_result(value_type&& result) {
-      assert(result_.index() == 0);
-
-      result_.template emplace<2>(std::move(result));
-      waiter_.resume();
-    }
+    return static_cast<std::size_t>(priority);
+  }
 
-    template<typename... Tys>
-    inline void resume_result(Tys&&... args) {
-      assert(result_.index() == 0);
+  template<std::size_t... Idxs>
+  static inline std::array<bucket_type, Levels>
+      make_buckets(allocator_type const& alloc,
+                   std::index_sequence<Idxs...> /*unused*/) {
+    return {((void)Idxs, bucket_type{alloc})...};
+  }
 
-      result_.template emplace<2>(std::forward<Tys>(args)...);
-      waiter_.resume();
-    }
+private:
+  std::array<bucket_type, Levels> buckets_;
+  std::uint64_t levels_{0};
+};
 
-    inline void resume_exception(std::exception_ptr const& exception) {
-      assert(exception != nullptr);
-      assert(result_.index() == 0);
+struct member_deadline {
+  template<typename Ty>
+  requires requires(Ty const& value) {
+    value.deadline();
+  }
+  inline auto operator()(Ty const& value) const noexcept {
+    return value.deadline();
+  }
+};
 
-      result_.template emplace<1>(std::move(exception));
-      waiter_.resume();
+namespace detail {
+  template<typename Fn, typename Ty>
+  inline auto invoke_on_item(Ty const& value) noexcept {
+    if constexpr (std::is_invocable_v<Fn, Ty const&>) {
+      return Fn{}(value);
     }
+    else {
+      return Fn{}(value.value());
+    }
+  }
 
-  private:
-    mutex_guard guard_;
-
-    std::variant<std::monostate, std::exception_ptr, value_type> result_;
-    std::coroutine_handle<> waiter_;
-
-    runque_awaitable* next_{nullptr};
+  template<typename Fn>
+  struct item_key {
+    template<typename Ty>
+    inline auto operator()(Ty const& value) const noexcept {
+      return invoke_on_item<Fn>(value);
+    }
   };
-
 } // namespace detail
 
-template<queuelike Queue>
-class runque<Queue, coro_thread_model> {
-private:
-  using queue_type = Queue;
-
+template<runnable Ty,
+         typename Deadline = member_deadline,
+         typename Alloc = std::allocator<Ty>>
+class edf_runque_queue {
 public:
-  using thread_model = coro_thread_model;
-  using value_type = typename queue_type::value_type;
-  using allocator_type = typename queue_type::allocator_type;
+  using value_type = Ty;
+  using allocator_type = Alloc;
 
-  using get_type = task<value_type>;
+  using time_point = std::decay_t<decltype(detail::invoke_on_item<Deadline>(
+      std::declval<value_type const&>()))>;
+  using clock_type = typename time_point::clock;
+  using duration = typename time_point::duration;
 
 private:
-  using awaitable_type = detail::runque_awaitable<value_type>;
+  using queue_type = keyed_priority_runque_queue<value_type,
+                                                 detail::item_key<Deadline>,
+                                                 allocator_type,
+                                                 std::greater<>>;
 
 public:
-  inline runque(allocator_type const& alloc = allocator_type{})
+  explicit inline edf_runque_queue(
+      allocator_type const& alloc = allocator_type{})
       : items_{alloc} {
   }
 
-  runque(runque const&) = delete;
-  runque(runque&&) = delete;
+  edf_runque_queue(edf_runque_queue const&) = delete;
+  edf_runque_queue(edf_runque_queue&&) = delete;
 
-  runque& operator=(runque const&) = delete;
-  runque& operator=(runque&&) = delete;
+  edf_runque_queue& operator=(edf_runque_queue const&) = delete;
+  edf_runque_queue& operator=(edf_runque_queue&&) = delete;
 
-  inline get_type get() {
-    co_await mutex_.lock();
-    awaitable_type awaitable{mutex_};
+  inline void push(value_type&& value) {
+    items_.push(std::move(value));
+  }
 
-    if (interrupted_) {
-      throw interrupted{};
-    }
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
+  }
 
-    if (!items_.empty()) {
-      co_return items_.pop();
-    }
+  inline value_type pop() noexcept {
+    auto result{items_.pop()};
+    record(result);
 
-    waiters_ = awaitable.set_next(waiters_);
+    return result;
+  }
 
-    co_return std::move(co_await awaitable);
+  // counts an item the runque passed to a waiting consumer without pushing it
+  inline void handed_off(value_type const& value) noexcept {
+    record(value);
   }
 
-  inline task<> put(value_type&& value) {
-    awaitable_type* awaken{nullptr};
+  inline bool empty() const noexcept {
+    return items_.empty();
+  }
 
-    {
-      co_await mutex_.lock();
-      mutex_guard guard{mutex_, std::adopt_lock};
+  inline std::size_t size() const noexcept {
+    return items_.size();
+  }
 
-      if (interrupted_) {
-        throw interrupted{};
-      }
+  inline std::uint64_t served() const noexcept {
+    return served_.load(std::memory_order_relaxed);
+  }
 
-      if (waiters_ == nullptr) {
-        items_.push(std::move(value));
-      }
-      else {
-        awaken = pop_waiter();
-      }
-    }
+  inline std::uint64_t missed() const noexcept {
+    return missed_.load(std::memory_order_relaxed);
+  }
 
-    if (awaken != nullptr) {
-      awaken->resume_result(std::move(value));
+  static inline time_point deadline(value_type const& value) noexcept {
+    return detail::invoke_on_item<Deadline>(value);
+  }
+
+  static inline duration slack(value_type const& value) noexcept {
+    return deadline(value) - clock_type::now();
+  }
+
+private:
+  inline void record(value_type const& value) noexcept {
+    served_.fetch_add(1, std::memory_order_relaxed);
+    if (slack(value) < duration::zero()) {
+      missed_.fetch_add(1, std::memory_order_relaxed);
     }
   }
 
-  template<typename... Tys>
-  requires(std::is_constructible_v<value_type, Tys...>) inline task<> put(
-      Tys&&... args) {
-    awaitable_type* awaken{nullptr};
+  queue_type items_;
+
+  std::atomic<std::uint64_t> served_{0};
+  std::atomic<std::uint64_t> missed_{0};
+};
+
+struct member_sequence {
+  template<typename Ty>
+  requires requires(Ty const& value) {
+    value.sequence();
+  }
+  inline auto operator()(Ty const& value) const noexcept {
+    return value.sequence();
+  }
+};
+
+template<runnable Ty,
+         typename Alloc = std::allocator<Ty>,
+         typename Sequence = member_sequence>
+class reservation_runque_queue
+    : public keyed_priority_runque_queue<Ty,
+                                         detail::item_key<Sequence>,
+                                         Alloc,
+                                         std::greater<>> {
+private:
+  using base_type = keyed_priority_runque_queue<Ty,
+                                                detail::item_key<Sequence>,
+                                                Alloc,
+                                                std::greater<>>;
+
+public:
+  static constexpr bool is_sequenced = true;
+
+  using base_type::base_type;
+};
+
+namespace detail {
+  template<typename Ty>
+  struct item_age {
+    using duration = std::chrono::steady_clock::duration;
+
+    static inline void set(Ty& value, duration age) noexcept {
+      if constexpr (requires { value.set_age(age); }) {
+        value.set_age(age);
+      }
+    }
+  };
+
+  template<typename Ty>
+  struct aging_entry {
+    std::chrono::steady_clock::time_point enqueued_;
+    std::chrono::steady_clock::rep key_;
+    Ty value_;
+  };
+
+  struct aging_key {
+    template<typename Ty>
+    inline auto operator()(aging_entry<Ty> const& entry) const noexcept {
+      return entry.key_;
+    }
+  };
+
+  // now - priority * interval, saturated to the range of the key
+  template<std::signed_integral Rep, std::integral Priority>
+  inline constexpr Rep
+      make_aging_key(Rep now, Priority priority, Rep interval) noexcept {
+    constexpr auto min = std::numeric_limits<Rep>::min();
+    constexpr auto max = std::numeric_limits<Rep>::max();
+
+    Rep offset{};
+    if (std::cmp_greater(priority, max / interval)) {
+      offset = max;
+    }
+    else if (std::cmp_less(priority, min / interval)) {
+      offset = min;
+    }
+    else {
+      offset = static_cast<Rep>(priority) * interval;
+    }
+
+    if (offset > 0 && now < min + offset) {
+      return min;
+    }
+
+    if (offset < 0 && now > max + offset) {
+      return max;
+    }
+
+    return now - offset;
+  }
+} // namespace detail
+
+template<runnable Ty, typename Priority, typename Alloc = std::allocator<Ty>>
+class aging_priority_runque_queue {
+public:
+  using value_type = Ty;
+  using allocator_type = Alloc;
+
+  static constexpr bool is_aging = true;
+
+  using clock_type = std::chrono::steady_clock;
+  using duration = clock_type::duration;
+
+private:
+  using entry_type = detail::aging_entry<value_type>;
+  using queue_type = keyed_priority_runque_queue<
+      entry_type,
+      detail::aging_key,
+      detail::rebind_alloc_t<allocator_type, entry_type>,
+      std::greater<>>;
+
+public:
+  explicit inline aging_priority_runque_queue(
+      allocator_type const& alloc = allocator_type{})
+      : items_{alloc} {
+  }
+
+  aging_priority_runque_queue(aging_priority_runque_queue const&) = delete;
+  aging_priority_runque_queue(aging_priority_runque_queue&&) = delete;
+
+  aging_priority_runque_queue&
+      operator=(aging_priority_runque_queue const&) = delete;
+  aging_priority_runque_queue&
+      operator=(aging_priority_runque_queue&&) = delete;
+
+  void push(value_type&& value) {
+    auto priority = detail::invoke_on_item<Priority>(std::as_const(value));
+
+    auto now = clock_type::now();
+    auto interval = interval_.load(std::memory_order_relaxed);
+    auto key = detail::make_aging_key(
+        now.time_since_epoch().count(), priority, interval);
+
+    items_.push(entry_type{now, key, std::move(value)});
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
+  }
+
+  inline value_type pop() noexcept {
+    auto entry{items_.pop()};
+
+    detail::item_age<value_type>::set(entry.value_,
+                                      clock_type::now() - entry.enqueued_);
+    return std::move(entry.value_);
+  }
+
+  inline bool empty() const noexcept {
+    return items_.empty();
+  }
+
+  inline std::size_t size() const noexcept {
+    return items_.size();
+  }
+
+  // keys of queued items are fixed at push, so items pushed before and after
+  // a change age at different rates until the older ones drain
+  inline void set_interval(duration interval) noexcept {
+    assert(interval.count() > 0);
+    interval_.store(interval.count(), std::memory_order_relaxed);
+  }
+
+  inline duration interval() const noexcept {
+    return duration{interval_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  queue_type items_;
+
+  std::atomic<duration::rep> interval_{
+      std::chrono::duration_cast<duration>(std::chrono::milliseconds{10})
+          .count()};
+};
+
+struct unit_cost {
+  template<typename Ty>
+  inline constexpr std::size_t operator()(Ty const& /*unused*/) const noexcept {
+    return 1;
+  }
+};
+
+namespace detail {
+  template<typename Ty, typename Key, typename Alloc>
+  struct fair_flow {
+    explicit inline fair_flow(Alloc const& alloc)
+        : items_{alloc} {
+    }
+
+    std::deque<Ty, Alloc> items_;
+    Key const* key_{nullptr};
+    fair_flow* next_{nullptr};
+
+    std::size_t deficit_{0};
+    bool credited_{false};
+  };
+} // namespace detail
+
+template<runnable Ty,
+         typename Key,
+         typename Alloc = std::allocator<Ty>,
+         typename Cost = unit_cost>
+class fair_runque_queue {
+public:
+  using value_type = Ty;
+  using allocator_type = Alloc;
+  using key_type = std::decay_t<decltype(detail::invoke_on_item<Key>(
+      std::declval<value_type const&>()))>;
+
+private:
+  using flow_type = detail::fair_flow<value_type, key_type, allocator_type>;
+
+  template<typename Value>
+  using map_type = std::unordered_map<
+      key_type,
+      Value,
+      std::hash<key_type>,
+      std::equal_to<key_type>,
+      detail::rebind_alloc_t<allocator_type,
+                             std::pair<const key_type, Value>>>;
+
+public:
+  explicit inline fair_runque_queue(
+      allocator_type const& alloc = allocator_type{})
+      : flows_{alloc}
+      , weights_{alloc} {
+  }
+
+  fair_runque_queue(fair_runque_queue const&) = delete;
+  fair_runque_queue(fair_runque_queue&&) = delete;
+
+  fair_runque_queue& operator=(fair_runque_queue const&) = delete;
+  fair_runque_queue& operator=(fair_runque_queue&&) = delete;
+
+  void push(value_type&& value) {
+    auto [pos, added] = flows_.try_emplace(
+        detail::invoke_on_item<Key>(std::as_const(value)),
+        flows_.get_allocator());
+
+    auto& flow = pos->second;
+    try {
+      flow.items_.push_back(std::move(value));
+    }
+    catch (...) {
+      if (added) {
+        flows_.erase(pos);
+      }
+
+      throw;
+    }
+
+    if (added) {
+      flow.key_ = &pos->first;
+      activate(flow);
+    }
+
+    ++size_;
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
+  }
+
+  value_type pop() noexcept {
+    assert(head_ != nullptr);
+
+    for (;;) {
+      auto& flow = *head_;
+
+      auto cost = static_cast<std::size_t>(
+          detail::invoke_on_item<Cost>(flow.items_.front()));
+
+      if (flow.deficit_ < cost) {
+        if (!flow.credited_) {
+          flow.deficit_ += weight(*flow.key_);
+          flow.credited_ = true;
+        }
+        else {
+          flow.credited_ = false;
+          rotate();
+        }
+
+        continue;
+      }
+
+      flow.deficit_ -= cost;
+
+      auto result{std::move(flow.items_.front())};
+      flow.items_.pop_front();
+
+      if (flow.items_.empty()) {
+        head_ = flow.next_;
+        flows_.erase(*flow.key_);
+      }
+
+      --size_;
+      return result;
+    }
+  }
+
+  inline bool empty() const noexcept {
+    return head_ == nullptr;
+  }
+
+  inline std::size_t size() const noexcept {
+    return size_;
+  }
+
+  void set_weight(key_type const& key, std::size_t weight) {
+    assert(weight != 0);
+
+    std::lock_guard guard{weights_lock_};
+    weights_.insert_or_assign(key, weight);
+  }
+
+  std::size_t weight(key_type const& key) const noexcept {
+    std::lock_guard guard{weights_lock_};
+
+    auto pos = weights_.find(key);
+    return pos != weights_.end() ? pos->second : 1;
+  }
+
+private:
+  inline void activate(flow_type& flow) noexcept {
+    if (head_ == nullptr) {
+      head_ = &flow;
+    }
+    else {
+      tail_->next_ = &flow;
+    }
+
+    tail_ = &flow;
+  }
+
+  inline void rotate() noexcept {
+    if (head_ != tail_) {
+      auto flow = std::exchange(head_, head_->next_);
+      flow->next_ = nullptr;
+
+      tail_->next_ = flow;
+      tail_ = flow;
+    }
+  }
+
+private:
+  map_type<flow_type> flows_;
+
+  flow_type* head_{nullptr};
+  flow_type* tail_{nullptr};
+
+  std::size_t size_{0};
+
+  mutable std::mutex weights_lock_;
+  map_type<std::size_t> weights_;
+};
+
+template<runnable Ty, typename Alloc = std::allocator<Ty>>
+class fifo_runque_queue
+    : public detail::base_runque_queue<std::queue<Ty, std::deque<Ty, Alloc>>,
+                                       Alloc> {
+private:
+  using base_type =
+      detail::base_runque_queue<std::queue<Ty, std::deque<Ty, Alloc>>, Alloc>;
+
+public:
+  using base_type::base_type;
+
+  inline auto pop() noexcept {
+    typename base_type::popper p{this->queue_};
+    return std::move(p.q.front());
+  }
+};
+
+template<runnable Ty, typename Alloc = std::allocator<Ty>>
+class lifo_runque_queue
+    : public detail::base_runque_queue<std::stack<Ty, std::vector<Ty, Alloc>>,
+                                       Alloc> {
+private:
+  using base_type =
+      detail::base_runque_queue<std::stack<Ty, std::vector<Ty, Alloc>>, Alloc>;
+
+public:
+  using base_type::base_type;
+
+  inline auto pop() noexcept {
+    typename base_type::popper p{this->queue_};
+    return std::move(p.q.top());
+  }
+};
+
+namespace detail {
+  template<typename Ty>
+  struct alignas(cache_line_size) mpmc_slot {
+    std::atomic<std::size_t> sequence_;
+    alignas(Ty) std::array<std::byte, sizeof(Ty)> storage_;
+  };
+
+  template<runnable Ty, typename Alloc, std::size_t Capacity>
+  class mpmc_ring {
+  public:
+    static_assert(std::has_single_bit(Capacity));
+
+    using value_type = Ty;
+    using slot_type = mpmc_slot<value_type>;
+    using allocator_type = rebind_alloc_t<Alloc, slot_type>;
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    static constexpr std::size_t mask = Capacity - 1;
+
+  public:
+    explicit inline mpmc_ring(allocator_type const& alloc)
+        : alloc_{alloc}
+        , slots_{alloc_traits::allocate(alloc_, Capacity)} {
+      for (std::size_t i = 0; i < Capacity; ++i) {
+        alloc_traits::construct(alloc_, slots_ + i);
+        slots_[i].sequence_.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    mpmc_ring(mpmc_ring const&) = delete;
+    mpmc_ring(mpmc_ring&&) = delete;
+
+    mpmc_ring& operator=(mpmc_ring const&) = delete;
+    mpmc_ring& operator=(mpmc_ring&&) = delete;
+
+    inline ~mpmc_ring() {
+      while (try_pop()) {
+      }
+
+      for (std::size_t i = 0; i < Capacity; ++i) {
+        alloc_traits::destroy(alloc_, slots_ + i);
+      }
+
+      alloc_traits::deallocate(alloc_, slots_, Capacity);
+    }
+
+    bool try_push(value_type&& value) noexcept {
+      auto pos = tail_.load(std::memory_order_relaxed);
+      for (;;) {
+        auto& slot = slots_[pos & mask];
+        auto diff = distance(slot.sequence_.load(std::memory_order_acquire),
+                             pos);
+
+        if (diff == 0) {
+          if (tail_.compare_exchange_weak(
+                  pos, pos + 1, std::memory_order_relaxed)) {
+            new (slot.storage_.data()) value_type{std::move(value)};
+            slot.sequence_.store(pos + 1, std::memory_order_release);
+
+            return true;
+          }
+        }
+        else if (diff < 0) {
+          return false;
+        }
+        else {
+          pos = tail_.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    std::optional<value_type> try_pop() noexcept {
+      auto pos = head_.load(std::memory_order_relaxed);
+      for (;;) {
+        auto& slot = slots_[pos & mask];
+        auto diff = distance(slot.sequence_.load(std::memory_order_acquire),
+                             pos + 1);
+
+        if (diff == 0) {
+          if (head_.compare_exchange_weak(
+                  pos, pos + 1, std::memory_order_relaxed)) {
+            auto item = std::launder(
+                reinterpret_cast<value_type*>(slot.storage_.data()));
+
+            std::optional<value_type> result{std::move(*item)};
+            item->~value_type();
+
+            slot.sequence_.store(pos + Capacity, std::memory_order_release);
+            return result;
+          }
+        }
+        else if (diff < 0) {
+          return {};
+        }
+        else {
+          pos = head_.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    inline bool empty() const noexcept {
+      return head_.load(std::memory_order_acquire) ==
+             tail_.load(std::memory_order_acquire);
+    }
+
+  private:
+    static inline std::intptr_t distance(std::size_t sequence,
+                                         std::size_t pos) noexcept {
+      return static_cast<std::intptr_t>(sequence - pos);
+    }
+
+  private:
+    [[no_unique_address]] allocator_type alloc_;
+    slot_type* slots_;
+
+    alignas(cache_line_size) std::atomic<std::size_t> head_{0};
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{0};
+  };
+} // namespace detail
+
+// bounded: a full ring rejects new items instead of growing, and a runque
+// built on it parks producers until consumers free a slot, so consumers
+// that also produce need a capacity their own output cannot fill
+template<runnable Ty,
+         typename Alloc = std::allocator<Ty>,
+         std::size_t Capacity = 1024>
+class mpmc_runque_queue {
+public:
+  using value_type = Ty;
+  using allocator_type = Alloc;
+
+  static constexpr bool is_internally_synchronized = true;
+
+private:
+  using ring_type = detail::mpmc_ring<value_type, allocator_type, Capacity>;
+
+public:
+  explicit inline mpmc_runque_queue(
+      allocator_type const& alloc = allocator_type{})
+      : ring_{typename ring_type::allocator_type{alloc}} {
+  }
+
+  mpmc_runque_queue(mpmc_runque_queue const&) = delete;
+  mpmc_runque_queue(mpmc_runque_queue&&) = delete;
+
+  mpmc_runque_queue& operator=(mpmc_runque_queue const&) = delete;
+  mpmc_runque_queue& operator=(mpmc_runque_queue&&) = delete;
+
+  inline bool try_push(value_type&& value) noexcept {
+    return ring_.try_push(std::move(value));
+  }
+
+  inline void push(value_type&& value) {
+    if (!ring_.try_push(std::move(value))) {
+      throw std::length_error{"mpmc runque queue is full"};
+    }
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
+  }
+
+  inline std::optional<value_type> try_pop() noexcept {
+    return ring_.try_pop();
+  }
+
+  // the head slot may be reserved by a producer that has not finished
+  // moving its item in, which takes no longer than a single move
+  inline value_type pop() noexcept {
+    for (std::uint32_t spins{0};; ++spins) {
+      if (auto result = ring_.try_pop(); result) {
+        return std::move(*result);
+      }
+
+      if (spins < 64) {
+        detail::cpu_relax();
+      }
+      else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  inline bool empty() const noexcept {
+    return ring_.empty();
+  }
+
+private:
+  ring_type ring_;
+};
+
+namespace detail {
+  template<typename Ty>
+  concept atomic_snapshot = std::is_trivially_copyable_v<Ty> &&
+      std::is_copy_constructible_v<Ty> && std::is_copy_assignable_v<Ty> &&
+      std::is_nothrow_default_constructible_v<Ty> &&
+      std::atomic<Ty>::is_always_lock_free;
+
+  struct no_relaxed_top {};
+
+  template<typename Ty, typename Alloc>
+  struct alignas(cache_line_size) relaxed_heap {
+    // items that fit a lock-free atomic publish a copy of the heap top so
+    // that two heaps can be compared without taking their locks
+    static constexpr bool caches_top = atomic_snapshot<Ty>;
+
+    using top_type =
+        std::conditional_t<caches_top, std::atomic<Ty>, no_relaxed_top>;
+
+    explicit inline relaxed_heap(Alloc const& alloc)
+        : items_{alloc} {
+    }
+
+    inline void publish() noexcept {
+      if constexpr (caches_top) {
+        if (!items_.empty()) {
+          top_.store(items_.front(), std::memory_order_relaxed);
+        }
+      }
+
+      size_.store(items_.size(), std::memory_order_release);
+    }
+
+    std::mutex lock_;
+    std::vector<Ty, Alloc> items_;
+    std::atomic<std::size_t> size_{0};
+    [[no_unique_address]] top_type top_{};
+  };
+
+  inline std::size_t relaxed_random() noexcept {
+    static thread_local std::uint64_t state{
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1U};
+
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+
+    return static_cast<std::size_t>(state);
+  }
+} // namespace detail
+
+template<runnable Ty,
+         typename Alloc = std::allocator<Ty>,
+         typename Less = std::less<Ty>,
+         std::size_t Factor = 2>
+class relaxed_priority_runque_queue {
+public:
+  using value_type = Ty;
+  using allocator_type = Alloc;
+
+  static constexpr bool is_internally_synchronized = true;
+
+private:
+  static constexpr std::size_t max_choices = 4;
+
+  using heap_type = detail::relaxed_heap<value_type, allocator_type>;
+  using heap_alloc_type = detail::rebind_alloc_t<allocator_type, heap_type>;
+  using heap_alloc_traits = std::allocator_traits<heap_alloc_type>;
+
+public:
+  explicit inline relaxed_priority_runque_queue(
+      allocator_type const& alloc = allocator_type{})
+      : relaxed_priority_runque_queue{
+            Factor * std::max(std::thread::hardware_concurrency(), 1U),
+            alloc} {
+  }
+
+  inline relaxed_priority_runque_queue(std::size_t heaps,
+                                       allocator_type const& alloc)
+      : alloc_{alloc}
+      , count_{std::max(heaps, std::size_t{1})} {
+    heaps_ = heap_alloc_traits::allocate(alloc_, count_);
+
+    std::size_t constructed{0};
+    try {
+      for (; constructed < count_; ++constructed) {
+        heap_alloc_traits::construct(alloc_, heaps_ + constructed, alloc);
+      }
+    }
+    catch (...) {
+      destroy(constructed);
+      throw;
+    }
+  }
+
+  relaxed_priority_runque_queue(relaxed_priority_runque_queue const&) = delete;
+  relaxed_priority_runque_queue(relaxed_priority_runque_queue&&) = delete;
+
+  relaxed_priority_runque_queue&
+      operator=(relaxed_priority_runque_queue const&) = delete;
+  relaxed_priority_runque_queue&
+      operator=(relaxed_priority_runque_queue&&) = delete;
+
+  inline ~relaxed_priority_runque_queue() {
+    destroy(count_);
+  }
+
+  inline void push(value_type&& value) {
+    auto& heap = heaps_[detail::relaxed_random() % count_];
+
+    std::lock_guard guard{heap.lock_};
+
+    heap.items_.push_back(std::move(value));
+    std::push_heap(heap.items_.begin(), heap.items_.end(), less_);
+
+    heap.publish();
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void push(
+      Tys&&... args) {
+    push(value_type{std::forward<Tys>(args)...});
+  }
+
+  std::optional<value_type> try_pop() noexcept {
+    for (std::size_t i = 0; i < max_choices; ++i) {
+      auto first = detail::relaxed_random() % count_;
+      auto second = detail::relaxed_random() % count_;
+
+      if (auto result = try_pop(heaps_[first], heaps_[second]); result) {
+        return result;
+      }
+    }
+
+    for (std::size_t i = 0; i < count_; ++i) {
+      auto& heap = heaps_[i];
+      if (heap.size_.load(std::memory_order_acquire) != 0) {
+        std::lock_guard guard{heap.lock_};
+        if (!heap.items_.empty()) {
+          return take(heap);
+        }
+      }
+    }
+
+    return {};
+  }
+
+  inline value_type pop() noexcept {
+    for (;;) {
+      if (auto result = try_pop(); result) {
+        return std::move(*result);
+      }
+
+      std::this_thread::yield();
+    }
+  }
+
+  inline bool empty() const noexcept {
+    for (std::size_t i = 0; i < count_; ++i) {
+      if (heaps_[i].size_.load(std::memory_order_acquire) != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  inline std::size_t heaps() const noexcept {
+    return count_;
+  }
+
+private:
+  std::optional<value_type> try_pop(heap_type& first,
+                                    heap_type& second) noexcept {
+    if (&first == &second) {
+      std::lock_guard guard{first.lock_};
+      return first.items_.empty() ? std::nullopt : take(first);
+    }
+
+    if (first.size_.load(std::memory_order_acquire) == 0) {
+      return try_pop(second, second);
+    }
+
+    if (second.size_.load(std::memory_order_acquire) == 0) {
+      return try_pop(first, first);
+    }
+
+    if constexpr (heap_type::caches_top) {
+      auto& chosen = less_(first.top_.load(std::memory_order_relaxed),
+                           second.top_.load(std::memory_order_relaxed))
+                         ? second
+                         : first;
+
+      return try_pop(chosen, chosen);
+    }
+    else {
+      std::scoped_lock guard{first.lock_, second.lock_};
+      if (first.items_.empty()) {
+        return second.items_.empty() ? std::nullopt : take(second);
+      }
+
+      if (second.items_.empty() ||
+          !less_(first.items_.front(), second.items_.front())) {
+        return take(first);
+      }
+
+      return take(second);
+    }
+  }
+
+  inline std::optional<value_type> take(heap_type& heap) noexcept {
+    std::pop_heap(heap.items_.begin(), heap.items_.end(), less_);
+
+    std::optional<value_type> result{std::move(heap.items_.back())};
+    heap.items_.pop_back();
+
+    heap.publish();
+
+    return result;
+  }
+
+  inline void destroy(std::size_t constructed) noexcept {
+    for (std::size_t i = 0; i < constructed; ++i) {
+      heap_alloc_traits::destroy(alloc_, heaps_ + i);
+    }
+
+    heap_alloc_traits::deallocate(alloc_, heaps_, count_);
+  }
+
+private:
+  [[no_unique_address]] heap_alloc_type alloc_;
+  [[no_unique_address]] Less less_{};
+
+  heap_type* heaps_{nullptr};
+  std::size_t count_;
+};
+
+template<typename Ty>
+class runque_tratis {
+  using port_type = Ty;
+
+  using value_model = typename port_type::value_model;
+  using thread_model = typename port_type::thread_model;
+  using return_type = std::decay_t<decltype(std::declval<port_type>().get())>;
+};
+
+struct priority_order {};
+struct keyed_priority_order {};
+struct bucket_priority_order {};
+struct edf_order {};
+struct fair_order {};
+struct reservation_order {};
+struct aging_priority_order {};
+struct fifo_order {};
+struct lifo_order {};
+struct mpmc_fifo_order {};
+struct relaxed_priority_order {};
+
+struct single_thread_model {};
+struct multi_thread_model {};
+struct coro_thread_model {};
+
+template<typename Ty>
+concept queuelike = requires(Ty q) {
+  typename Ty::value_type;
+  typename Ty::allocator_type;
+
+  requires runnable<typename Ty::value_type>;
+
+  { q.pop() }
+  ->std::same_as<typename Ty::value_type>;
+  {q.push(std::declval<typename Ty::value_type&&>())};
+  { q.empty() }
+  ->std::same_as<bool>;
+};
+
+template<typename Ty>
+concept synchronized_queuelike = queuelike<Ty> && requires(Ty q) {
+  { q.try_pop() }
+  ->std::same_as<std::optional<typename Ty::value_type>>;
+
+  requires Ty::is_internally_synchronized;
+};
+
+template<typename Ty>
+concept bounded_queuelike = synchronized_queuelike<Ty> && requires(Ty q) {
+  { q.try_push(std::declval<typename Ty::value_type&&>()) }
+  ->std::same_as<bool>;
+};
+
+template<typename Ty>
+concept runlike = requires(Ty s) {
+  typename Ty::value_type;
+  requires runnable<typename Ty::value_type>;
+  typename Ty::get_type;
+
+  { s.get() }
+  ->std::same_as<typename Ty::get_type>;
+  {s.put(std::declval<typename Ty::value_type&&>())};
+};
+
+template<typename Ty>
+concept batch_runlike = runlike<Ty> && requires(Ty s) {
+  {s.put_many(std::declval<std::span<typename Ty::value_type>>())};
+};
+
+template<typename Ty>
+concept pollable_runlike = runlike<Ty> && requires(Ty s) {
+  { s.try_get() }
+  ->std::same_as<std::optional<typename Ty::value_type>>;
+};
+
+template<typename Ty>
+concept timed_runlike = runlike<Ty> && requires(Ty s,
+                                               timer_wheel::time_point deadline,
+                                               timer_wheel& timers) {
+  { s.get_until(deadline, timers) }
+  ->std::same_as<task<std::optional<typename Ty::value_type>>>;
+};
+
+template<typename Ty>
+concept cancellable_runlike = runlike<Ty> && requires(Ty s,
+                                                     std::stop_token stop) {
+  { s.get(stop) }
+  ->std::same_as<typename Ty::get_type>;
+};
+
+template<typename Ty>
+concept executor_runlike = runlike<Ty> && requires(Ty s, executor_ref exec) {
+  { s.get(exec) }
+  ->std::same_as<typename Ty::get_type>;
+};
+
+namespace detail {
+template<typename Queue>
+concept handoff_observer =
+    requires(Queue& q, typename Queue::value_type const& value) {
+  q.handed_off(value);
+};
+
+template<typename Queue>
+inline void notify_handoff(Queue& queue,
+                          typename Queue::value_type const& value) noexcept {
+  if constexpr (handoff_observer<Queue>) {
+    queue.handed_off(value);
+  }
+}
+} // namespace detail
+
+template<queuelike Queue, typename Mtm>
+class runque;
+
+template<queuelike Queue>
+class runque<Queue, single_thread_model> {
+private:
+  using queue_type = Queue;
+
+public:
+  using thread_model = single_thread_model;
+  using value_type = typename queue_type::value_type;
+  using allocator_type = typename queue_type::allocator_type;
+
+  using get_type = std::optional<value_type>;
+
+public:
+  inline runque(allocator_type const& alloc = allocator_type{})
+      : items_{alloc} {
+  }
+
+  runque(runque const&) = delete;
+  runque(runque&&) = delete;
+
+  runque& operator=(runque const&) = delete;
+  runque& operator=(runque&&) = delete;
+
+  inline get_type get() {
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    if (!items_.empty()) {
+      return items_.pop();
+    }
+
+    return {};
+  }
+
+  inline void put(value_type&& value) {
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    items_.push(std::move(value));
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void put(
+      Tys&&... args) {
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    items_.push(std::forward<Tys>(args)...);
+  }
+
+  inline void put_many(std::span<value_type> values) {
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    for (auto& value : values) {
+      items_.push(std::move(value));
+    }
+  }
+
+  inline void interrupt() noexcept {
+    interrupted_ = true;
+  }
+
+  inline queue_type& get_queue() noexcept {
+    return items_;
+  }
+
+private:
+  bool interrupted_{false};
+  queue_type items_;
+};
+
+namespace detail {
+  template<std::uint32_t Min, std::uint32_t Max>
+  class adaptive_spin {
+  public:
+    template<typename Pred>
+    bool spin(Pred&& pred) noexcept {
+      auto budget = budget_.load(std::memory_order_relaxed);
+      for (std::uint32_t i = 0; i < budget; ++i) {
+        if (pred()) {
+          budget_.store(std::min(budget * 2, Max), std::memory_order_relaxed);
+          return true;
+        }
+
+        cpu_relax();
+      }
+
+      budget_.store(std::max(budget / 2, Min), std::memory_order_relaxed);
+      return false;
+    }
+
+  private:
+    std::atomic<std::uint32_t> budget_{Min};
+  };
+} // namespace detail
+
+template<queuelike Queue>
+class runque<Queue, multi_thread_model> {
+private:
+  using queue_type = Queue;
+
+public:
+  using thread_model = multi_thread_model;
+  using value_type = typename queue_type::value_type;
+  using allocator_type = typename queue_type::allocator_type;
+
+  using get_type = value_type;
+
+private:
+  using lock_type = std::unique_lock<std::mutex>;
+
+public:
+  inline runque(allocator_type const& alloc = allocator_type{})
+      : items_{alloc} {
+  }
+
+  runque(runque const&) = delete;
+  runque(runque&&) = delete;
+
+  runque& operator=(runque const&) = delete;
+  runque& operator=(runque&&) = delete;
+
+  get_type get() {
+    spin();
+
+    lock_type lock{lock_};
+    ++sleepers_;
+    cond_.wait(lock, [this] { return ready(); });
+    --sleepers_;
+
+    return pop();
+  }
+
+  std::optional<value_type> try_get() {
+    if (size_.load(std::memory_order_acquire) == 0 &&
+        !interrupted_.load(std::memory_order_relaxed)) {
+      return {};
+    }
+
+    lock_type lock{lock_, std::try_to_lock};
+    if (!lock.owns_lock() || !ready()) {
+      return {};
+    }
+
+    return pop();
+  }
+
+  template<typename Rep, typename Period>
+  inline std::optional<value_type>
+      get_for(std::chrono::duration<Rep, Period> const& timeout) {
+    return get_until(std::chrono::steady_clock::now() + timeout);
+  }
+
+  template<typename Clock, typename Duration>
+  std::optional<value_type>
+      get_until(std::chrono::time_point<Clock, Duration> const& deadline) {
+    spin();
+
+    lock_type lock{lock_};
+    ++sleepers_;
+    auto woken = cond_.wait_until(lock, deadline, [this] { return ready(); });
+    --sleepers_;
+
+    if (!woken) {
+      return {};
+    }
+
+    return pop();
+  }
+
+  inline void put(value_type&& value) {
+    bool wake{false};
+
+    {
+      lock_type lock{lock_};
+      if (interrupted_) {
+        throw interrupted{};
+      }
+
+      items_.push(std::move(value));
+      size_.fetch_add(1, std::memory_order_release);
+
+      wake = sleepers_ != 0;
+    }
+
+    if (wake) {
+      cond_.notify_one();
+    }
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline void put(
+      Tys&&... args) {
+    put(value_type{std::forward<Tys>(args)...});
+  }
+
+  void put_many(std::span<value_type> values) {
+    std::size_t wake{0};
+
+    {
+      lock_type lock{lock_};
+      if (interrupted_) {
+        throw interrupted{};
+      }
+
+      for (auto& value : values) {
+        items_.push(std::move(value));
+      }
+
+      size_.fetch_add(values.size(), std::memory_order_release);
+
+      wake = std::min(values.size(), sleepers_);
+    }
+
+    for (; wake != 0; --wake) {
+      cond_.notify_one();
+    }
+  }
+
+  // the lock only orders the flag against sleepers testing their predicate;
+  // unlike lock(), try_lock() never throws
+  inline void interrupt() noexcept {
+    interrupted_.store(true, std::memory_order_relaxed);
+
+    while (!lock_.try_lock()) {
+      std::this_thread::yield();
+    }
+
+    lock_.unlock();
+    cond_.notify_all();
+  }
+
+  template<std::invocable<queue_type&> Fn>
+  inline void with_queue(Fn fn) {
+    lock_type lock{lock_};
+    fn(items_);
+  }
+
+  inline queue_type& get_queue() noexcept {
+    return items_;
+  }
+
+private:
+  inline bool ready() const noexcept {
+    return interrupted_ || !items_.empty();
+  }
+
+  inline value_type pop() {
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return items_.pop();
+  }
+
+  inline void spin() noexcept {
+    spin_.spin([this] {
+      return size_.load(std::memory_order_acquire) != 0 ||
+             interrupted_.load(std::memory_order_relaxed);
+    });
+  }
+
+private:
+  queue_type items_;
+
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::size_t sleepers_{0};
+
+  alignas(detail::cache_line_size) std::atomic<std::size_t> size_{0};
+  std::atomic<bool> interrupted_{false};
+
+  detail::adaptive_spin<16, 4096> spin_;
+};
+
+enum class wake_order { lifo, fifo };
+
+namespace detail {
+  // shared by a parked waiter and the coroutine that expires or cancels it;
+  // cleared under the runque lock once the waiter leaves the list
+  template<typename Awaitable>
+  struct waiter_abort {
+    Awaitable* awaitable_{nullptr};
+  };
+
+  template<typename Awaitable>
+  struct waiter_links {
+    Awaitable* next_{nullptr};
+    Awaitable* prev_{nullptr};
+    waiter_abort<Awaitable>* abort_{nullptr};
+    bool linked_{false};
+  };
+
+  struct expired_result {};
+
+  template<runnable Ty>
+  class runque_awaitable {
+  public:
+    using value_type = Ty;
+
+    class parked {
+    public:
+      inline explicit parked(runque_awaitable& awaitable) noexcept
+          : awaitable_{&awaitable} {
+      }
+
+      inline bool await_ready() noexcept {
+        return false;
+      }
+
+      inline void await_suspend(std::coroutine_handle<> waiter) noexcept {
+        awaitable_->await_suspend(waiter);
+      }
+
+      inline void await_resume() noexcept {
+      }
+
+    private:
+      runque_awaitable* awaitable_;
+    };
+
+  public:
+    inline runque_awaitable(mutex& lock, executor_ref exec = {}) noexcept
+        : guard_{lock, std::adopt_lock}
+        , executor_{exec} {};
+
+    inline bool await_ready() noexcept {
+      return false;
+    }
+
+    inline void await_suspend(std::coroutine_handle<> waiter) noexcept {
+      waiter_ = waiter;
+      sink(guard_);
+    }
+
+    inline value_type& await_resume() & {
+      return result();
+    }
+
+    inline parked park() noexcept {
+      return parked{*this};
+    }
+
+    inline value_type& result() & {
+      switch (result_.index()) {
+      case 1: std::rethrow_exception(std::get<1>(result_));
+      case 2: return std::get<2>(result_);
+      default: throw std::logic_error{"invalid coroutine result"};
+      }
+    }
+
+    inline bool expired() const noexcept {
+      return result_.index() == 3;
+    }
+
+    inline waiter_links<runque_awaitable>& links() noexcept {
+      return links_;
+    }
+
+    inline void resume_result(value_type&& result) {
+      assert(result_.index() == 0);
+
+      result_.template emplace<2>(std::move(result));
+      executor_.post(waiter_);
+    }
+
+    template<typename... Tys>
+    inline void resume_result(Tys&&... args) {
+      assert(result_.index() == 0);
+
+      result_.template emplace<2>(std::forward<Tys>(args)...);
+      executor_.post(waiter_);
+    }
+
+    inline void resume_exception(std::exception_ptr const& exception) {
+      assert(exception != nullptr);
+      assert(result_.index() == 0);
+
+      result_.template emplace<1>(std::move(exception));
+      executor_.post(waiter_);
+    }
+
+    inline void resume_expired() {
+      assert(result_.index() == 0);
+
+      result_.template emplace<3>();
+      executor_.post(waiter_);
+    }
+
+  private:
+    mutex_guard guard_;
+
+    std::variant<std::monostate,
+                 std::exception_ptr,
+                 value_type,
+                 expired_result>
+        result_;
+    std::coroutine_handle<> waiter_;
+    executor_ref executor_;
+
+    waiter_links<runque_awaitable> links_;
+  };
+
+  template<typename Awaitable>
+  class waiter_list {
+  public:
+    inline bool empty() const noexcept {
+      return head_ == nullptr;
+    }
+
+    inline void push(Awaitable& waiter, wake_order order) noexcept {
+      auto& links = waiter.links();
+      links.linked_ = true;
+
+      if (order == wake_order::fifo) {
+        links.prev_ = tail_;
+        links.next_ = nullptr;
+        (tail_ != nullptr ? tail_->links().next_ : head_) = &waiter;
+        tail_ = &waiter;
+      }
+      else {
+        links.prev_ = nullptr;
+        links.next_ = head_;
+        (head_ != nullptr ? head_->links().prev_ : tail_) = &waiter;
+        head_ = &waiter;
+      }
+    }
+
+    inline Awaitable* pop() noexcept {
+      auto waiter{head_};
+      erase(*waiter);
+      return waiter;
+    }
+
+    inline bool erase(Awaitable& waiter) noexcept {
+      auto& links = waiter.links();
+      if (!links.linked_) {
+        return false;
+      }
+
+      (links.prev_ != nullptr ? links.prev_->links().next_ : head_) =
+          links.next_;
+      (links.next_ != nullptr ? links.next_->links().prev_ : tail_) =
+          links.prev_;
+
+      links.linked_ = false;
+      disarm(waiter);
+
+      return true;
+    }
+
+    static inline void arm(Awaitable& waiter,
+                           waiter_abort<Awaitable>& abort) noexcept {
+      abort.awaitable_ = &waiter;
+      waiter.links().abort_ = &abort;
+    }
+
+    static inline void disarm(Awaitable& waiter) noexcept {
+      if (auto abort = std::exchange(waiter.links().abort_, nullptr);
+          abort != nullptr) {
+        abort->awaitable_ = nullptr;
+      }
+    }
+
+    inline Awaitable* release() noexcept {
+      for (auto waiter = head_; waiter != nullptr;
+           waiter = waiter->links().next_) {
+        waiter->links().linked_ = false;
+        disarm(*waiter);
+      }
+
+      tail_ = nullptr;
+      return std::exchange(head_, nullptr);
+    }
+
+  private:
+    Awaitable* head_{nullptr};
+    Awaitable* tail_{nullptr};
+  };
+
+  class park_policy {
+  public:
+    static constexpr std::uint32_t yield_period = 64;
+
+    inline void set_wake_order(wake_order order) noexcept {
+      order_.store(order, std::memory_order_relaxed);
+    }
+
+    inline wake_order get_wake_order() const noexcept {
+      return order_.load(std::memory_order_relaxed);
+    }
+
+    inline void set_spin_limit(std::uint32_t limit) noexcept {
+      limit_.store(limit, std::memory_order_relaxed);
+    }
+
+    inline std::uint32_t get_spin_limit() const noexcept {
+      return limit_.load(std::memory_order_relaxed);
+    }
+
+    template<typename Pred>
+    bool spin(Pred&& pred) const noexcept {
+      auto limit = limit_.load(std::memory_order_relaxed);
+      for (std::uint32_t i = 0; i < limit; ++i) {
+        if (pred()) {
+          return true;
+        }
+
+        if ((i + 1) % yield_period == 0) {
+          std::this_thread::yield();
+        }
+        else {
+          cpu_relax();
+        }
+      }
+
+      return false;
+    }
+
+  private:
+    std::atomic<wake_order> order_{wake_order::lifo};
+    std::atomic<std::uint32_t> limit_{0};
+  };
+
+  // a suspended coroutine that, once posted, runs to completion and frees
+  // itself; destroyed unstarted if it is never posted
+  class detached_task {
+  public:
+    class promise_type {
+    public:
+      inline detached_task get_return_object() noexcept {
+        return detached_task{
+            std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+
+      inline std::suspend_always initial_suspend() noexcept {
+        return {};
+      }
+
+      inline std::suspend_never final_suspend() noexcept {
+        return {};
+      }
+
+      inline void return_void() noexcept {
+      }
+
+      [[noreturn]] inline void unhandled_exception() noexcept {
+        std::terminate();
+      }
+    };
+
+  public:
+    inline detached_task(detached_task&& other) noexcept
+        : handle_{std::exchange(other.handle_, nullptr)} {
+    }
+
+    inline ~detached_task() {
+      if (handle_) {
+        handle_.destroy();
+      }
+    }
+
+    detached_task(detached_task const&) = delete;
+
+    detached_task& operator=(detached_task const&) = delete;
+    detached_task& operator=(detached_task&&) = delete;
+
+    // running the coroutine may destroy this object, so the handle is
+    // released up front and taken back only if the executor rejects it
+    inline void post(executor_ref exec) {
+      if (handle_) {
+        auto handle = std::exchange(handle_, nullptr);
+        try {
+          exec.post(handle);
+        }
+        catch (...) {
+          handle_ = handle;
+          throw;
+        }
+      }
+    }
+
+  private:
+    inline explicit detached_task(std::coroutine_handle<> handle) noexcept
+        : handle_{handle} {
+    }
+
+  private:
+    std::coroutine_handle<> handle_;
+  };
+
+  class runque_timeout {
+  public:
+    inline runque_timeout(timer_wheel& timers, detached_task&& expiry) noexcept
+        : timers_{&timers}
+        , expiry_{std::move(expiry)}
+        , entry_{&expire, this} {
+    }
+
+    inline void schedule(timer_wheel::time_point deadline) {
+      timers_->schedule(entry_, deadline);
+    }
+
+    inline void cancel() {
+      timers_->cancel(entry_);
+    }
+
+  private:
+    static void expire(void* context) noexcept {
+      auto* self = static_cast<runque_timeout*>(context);
+      self->expiry_.post(self->timers_->executor());
+    }
+
+  private:
+    timer_wheel* timers_;
+    detached_task expiry_;
+
+    timer_entry entry_;
+  };
+} // namespace detail
+
+template<queuelike Queue>
+class runque<Queue, coro_thread_model> {
+private:
+  using queue_type = Queue;
+
+public:
+  using thread_model = coro_thread_model;
+  using value_type = typename queue_type::value_type;
+  using allocator_type = typename queue_type::allocator_type;
+
+  using get_type = task<value_type>;
+
+private:
+  using awaitable_type = detail::runque_awaitable<value_type>;
+  using abort_type = detail::waiter_abort<awaitable_type>;
+
+public:
+  inline runque(allocator_type const& alloc = allocator_type{})
+      : items_{alloc} {
+  }
+
+  runque(runque const&) = delete;
+  runque(runque&&) = delete;
+
+  runque& operator=(runque const&) = delete;
+  runque& operator=(runque&&) = delete;
+
+  inline get_type get(executor_ref exec = {}) {
+    policy_.spin([this] { return ready_.load(std::memory_order_relaxed); });
+
+    co_await mutex_.lock();
+    awaitable_type awaitable{mutex_, exec};
+
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    if (!items_.empty()) {
+      auto result{items_.pop()};
+      ready_.store(!items_.empty(), std::memory_order_relaxed);
+
+      co_return result;
+    }
+
+    waiters_.push(awaitable, policy_.get_wake_order());
+
+    co_return std::move(co_await awaitable);
+  }
+
+  get_type get(std::stop_token stop, executor_ref exec = {}) {
+    co_await mutex_.lock();
+    awaitable_type awaitable{mutex_, exec};
+
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    if (stop.stop_requested()) {
+      throw cancelled{};
+    }
+
+    if (!items_.empty()) {
+      auto result{items_.pop()};
+      ready_.store(!items_.empty(), std::memory_order_relaxed);
+
+      co_return result;
+    }
+
+    auto abort = std::make_unique<abort_type>();
+    auto& parked = *abort;
+
+    auto cancellation =
+        abort_waiter(std::move(abort), std::make_exception_ptr(cancelled{}));
+
+    waiters_.push(awaitable, policy_.get_wake_order());
+    waiters_.arm(awaitable, parked);
+
+    std::stop_callback on_stop{
+        stop, [&cancellation, exec] { cancellation.post(exec); }};
+
+    co_return std::move(co_await awaitable);
+  }
+
+  task<std::optional<value_type>>
+      get_until(timer_wheel::time_point deadline,
+                timer_wheel& timers = default_timer_wheel(),
+                executor_ref exec = {}) {
+    policy_.spin([this] { return ready_.load(std::memory_order_relaxed); });
+
+    co_await mutex_.lock();
+    awaitable_type awaitable{mutex_, exec};
+
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    if (!items_.empty()) {
+      std::optional<value_type> result{items_.pop()};
+      ready_.store(!items_.empty(), std::memory_order_relaxed);
+
+      co_return result;
+    }
+
+    if (timer_wheel::clock_type::now() >= deadline) {
+      co_return std::nullopt;
+    }
+
+    auto abort = std::make_unique<abort_type>();
+    auto& parked = *abort;
+
+    detail::runque_timeout timeout{timers, abort_waiter(std::move(abort), {})};
+
+    waiters_.push(awaitable, policy_.get_wake_order());
+    waiters_.arm(awaitable, parked);
+
+    timeout.schedule(deadline);
+
+    co_await awaitable.park();
+    if (awaitable.expired()) {
+      co_return std::nullopt;
+    }
+
+    timeout.cancel();
+    co_return std::move(awaitable.result());
+  }
+
+  template<typename Rep, typename Period>
+  inline task<std::optional<value_type>>
+      get_for(std::chrono::duration<Rep, Period> const& timeout,
+              timer_wheel& timers = default_timer_wheel(),
+              executor_ref exec = {}) {
+    return get_until(
+        timer_wheel::clock_type::now() +
+            std::chrono::duration_cast<timer_wheel::duration>(timeout),
+        timers,
+        exec);
+  }
+
+  std::optional<value_type> try_get() {
+    if (!ready_.load(std::memory_order_relaxed) || !mutex_.try_lock()) {
+      return {};
+    }
+
+    mutex_guard guard{mutex_, std::adopt_lock};
+
+    if (interrupted_) {
+      throw interrupted{};
+    }
+
+    if (items_.empty()) {
+      return {};
+    }
+
+    auto result{items_.pop()};
+    ready_.store(!items_.empty(), std::memory_order_relaxed);
+
+    return result;
+  }
+
+  inline task<> put(value_type&& value) {
+    awaitable_type* awaken{nullptr};
+
+    {
+      co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      if (interrupted_) {
+        throw interrupted{};
+      }
+
+      if (waiters_.empty()) {
+        items_.push(std::move(value));
+        ready_.store(true, std::memory_order_relaxed);
+      }
+      else {
+        awaken = waiters_.pop();
+        detail::notify_handoff(items_, value);
+      }
+    }
+
+    if (awaken != nullptr) {
+      awaken->resume_result(std::move(value));
+    }
+  }
+
+  template<typename... Tys>
+  requires(std::is_constructible_v<value_type, Tys...>) inline task<> put(
+      Tys&&... args) {
+    if constexpr (detail::handoff_observer<queue_type>) {
+      co_await put(value_type{std::forward<Tys>(args)...});
+    }
+    else {
+      awaitable_type* awaken{nullptr};
+
+      {
+        co_await mutex_.lock();
+        mutex_guard guard{mutex_, std::adopt_lock};
+
+        if (interrupted_) {
+          throw interrupted{};
+        }
+
+        if (waiters_.empty()) {
+          items_.push(std::forward<Tys>(args)...);
+          ready_.store(true, std::memory_order_relaxed);
+        }
+        else {
+          awaken = waiters_.pop();
+        }
+      }
+
+      if (awaken != nullptr) {
+        awaken->resume_result(std::forward<Tys>(args)...);
+      }
+    }
+  }
+
+  task<> put_many(std::span<value_type> values) {
+    detail::waiter_list<awaitable_type> awaken{};
+    std::size_t woken{0};
+
+    {
+      co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      if (interrupted_) {
+        throw interrupted{};
+      }
+
+      for (; woken < values.size() && !waiters_.empty(); ++woken) {
+        awaken.push(*waiters_.pop(), wake_order::fifo);
+        detail::notify_handoff(items_, values[woken]);
+      }
+
+      for (auto& value : values.subspan(woken)) {
+        items_.push(std::move(value));
+      }
+
+      ready_.store(!items_.empty(), std::memory_order_relaxed);
+    }
+
+    for (auto& value : values.first(woken)) {
+      awaken.pop()->resume_result(std::move(value));
+    }
+  }
+
+  inline task<> interrupt() noexcept {
+    awaitable_type* waiters{nullptr};
+
+    {
+      co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      interrupted_ = true;
+      ready_.store(true, std::memory_order_relaxed);
+
+      waiters = waiters_.release();
+    }
+
+    auto exception = std::make_exception_ptr(interrupted{});
+    while (waiters != nullptr) {
+      auto next = waiters->links().next_;
+      waiters->resume_exception(exception);
+      waiters = next;
+    }
+  }
+
+  inline queue_type& get_queue() noexcept {
+    return items_;
+  }
+
+  template<std::invocable<queue_type&> Fn>
+  inline task<> with_queue(Fn fn) {
+    co_await mutex_.lock();
+    mutex_guard guard{mutex_, std::adopt_lock};
+
+    fn(items_);
+    ready_.store(!items_.empty(), std::memory_order_relaxed);
+  }
+
+  inline void set_wake_order(wake_order order) noexcept {
+    policy_.set_wake_order(order);
+  }
+
+  inline wake_order get_wake_order() const noexcept {
+    return policy_.get_wake_order();
+  }
+
+  inline void set_spin_limit(std::uint32_t limit) noexcept {
+    policy_.set_spin_limit(limit);
+  }
+
+  inline std::uint32_t get_spin_limit() const noexcept {
+    return policy_.get_spin_limit();
+  }
+
+private:
+  // expires the waiter when error is null, fails it with error otherwise
+  detail::detached_task abort_waiter(std::unique_ptr<abort_type> abort,
+                                     std::exception_ptr error) {
+    awaitable_type* awaken{nullptr};
+
+    {
+      co_await mutex_.lock();
+      mutex_guard guard{mutex_, std::adopt_lock};
+
+      awaken = abort->awaitable_;
+      if (awaken == nullptr) {
+        co_return;
+      }
+
+      waiters_.erase(*awaken);
+    }
+
+    if (error != nullptr) {
+      awaken->resume_exception(error);
+    }
+    else {
+      awaken->resume_expired();
+    }
+  }
+
+private:
+  detail::waiter_list<awaitable_type> waiters_;
+  queue_type items_;
+
+  bool interrupted_{false};
+  std::atomic<bool> ready_{false};
+
+  detail::park_policy policy_;
+
+  mutex mutex_;
+};
+
+namespace detail {
+  // producers parked on a full bounded queue; each item a consumer takes
+  // wakes one of them, and the gate is not touched until the queue fills up
+  class space_gate {
+  private:
+    struct node {
+      std::coroutine_handle<> handle_;
+      node* next_{nullptr};
+    };
+
+  public:
+    template<typename Retry>
+    class awaitable : node {
+    public:
+      inline awaitable(space_gate& gate, Retry retry) noexcept
+          : gate_{&gate}
+          , retry_{std::move(retry)} {
+      }
+
+      inline bool await_ready() noexcept {
+        return false;
+      }
+
+      // the retry runs after the producer is counted as parked, so a slot
+      // freed by a consumer that missed the count is still seen here
+      inline bool await_suspend(std::coroutine_handle<> handle) noexcept {
+        this->handle_ = handle;
+
+        gate_->lock();
+        gate_->parked_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        pushed_ = !gate_->open_ && retry_();
+        if (gate_->open_ || pushed_) {
+          gate_->parked_.fetch_sub(1, std::memory_order_relaxed);
+          gate_->unlock();
+          return false;
+        }
+
+        gate_->append(*this);
+        gate_->unlock();
+        return true;
+      }
+
+      inline bool await_resume() noexcept {
+        return pushed_;
+      }
+
+    private:
+      space_gate* gate_;
+      Retry retry_;
+      bool pushed_{false};
+    };
+
+  public:
+    template<typename Retry>
+    inline awaitable<Retry> wait(Retry retry) noexcept {
+      return awaitable<Retry>{*this, std::move(retry)};
+    }
+
+    inline void notify() noexcept {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (parked_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+
+      lock();
+      auto awaken = head_;
+      if (awaken != nullptr) {
+        head_ = std::exchange(awaken->next_, nullptr);
+        if (head_ == nullptr) {
+          tail_ = nullptr;
+        }
+
+        parked_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      unlock();
+
+      if (awaken != nullptr) {
+        awaken->handle_.resume();
+      }
+    }
+
+    inline void open() noexcept {
+      lock();
+      open_ = true;
+      auto awaken = std::exchange(head_, nullptr);
+      tail_ = nullptr;
+      parked_.store(0, std::memory_order_relaxed);
+      unlock();
+
+      while (awaken != nullptr) {
+        std::exchange(awaken, awaken->next_)->handle_.resume();
+      }
+    }
+
+  private:
+    inline void lock() noexcept {
+      while (lock_.test_and_set(std::memory_order_acquire)) {
+        cpu_relax();
+      }
+    }
+
+    inline void unlock() noexcept {
+      lock_.clear(std::memory_order_release);
+    }
+
+    inline void append(node& waiter) noexcept {
+      if (tail_ == nullptr) {
+        head_ = &waiter;
+      }
+      else {
+        tail_->next_ = &waiter;
+      }
+
+      tail_ = &waiter;
+    }
+
+  private:
+    std::atomic<std::size_t> parked_{0};
+    std::atomic_flag lock_{};
+    node* head_{nullptr};
+    node* tail_{nullptr};
+    bool open_{false};
+  };
+
+  struct no_space_gate {};
+
+  template<typename Derived, runnable Ty, bool Bounded = false>
+  class counted_runque {
+  public:
+    using value_type = Ty;
+    using get_type = task<value_type>;
+
+  private:
+    using awaitable_type = runque_awaitable<value_type>;
+    using abort_type = waiter_abort<awaitable_type>;
+
+  public:
+    counted_runque(counted_runque const&) = delete;
+    counted_runque(counted_runque&&) = delete;
+
+    counted_runque& operator=(counted_runque const&) = delete;
+    counted_runque& operator=(counted_runque&&) = delete;
+
+    inline get_type get(executor_ref exec = {}) {
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      policy_.spin(
+          [this] { return available_.load(std::memory_order_relaxed) > 0; });
+
+      if (available_.fetch_sub(1, std::memory_order_acq_rel) > 0) {
+        co_return take();
+      }
 
-    {
       co_await mutex_.lock();
-      mutex_guard guard{mutex_, std::adopt_lock};
+      awaitable_type awaitable{mutex_, exec};
 
-      if (interrupted_) {
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      if (signals_ != 0) {
+        --signals_;
+        co_return take();
+      }
+
+      waiters_.push(awaitable, policy_.get_wake_order());
+
+      co_return std::move(co_await awaitable);
+    }
+
+    get_type get(std::stop_token stop, executor_ref exec = {}) {
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      if (stop.stop_requested()) {
+        throw cancelled{};
+      }
+
+      policy_.spin(
+          [this] { return available_.load(std::memory_order_relaxed) > 0; });
+
+      if (available_.fetch_sub(1, std::memory_order_acq_rel) > 0) {
+        co_return take();
+      }
+
+      co_await mutex_.lock();
+      awaitable_type awaitable{mutex_, exec};
+
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      if (signals_ != 0) {
+        --signals_;
+        co_return take();
+      }
+
+      if (stop.stop_requested() && withdraw()) {
+        throw cancelled{};
+      }
+
+      auto abort = std::make_unique<abort_type>();
+      auto& parked = *abort;
+
+      auto cancellation = abort_waiter(std::move(abort),
+                                       std::make_exception_ptr(cancelled{}));
+
+      waiters_.push(awaitable, policy_.get_wake_order());
+      waiters_.arm(awaitable, parked);
+
+      std::stop_callback on_stop{
+          stop, [&cancellation, exec] { cancellation.post(exec); }};
+
+      co_return std::move(co_await awaitable);
+    }
+
+    task<std::optional<value_type>>
+        get_until(timer_wheel::time_point deadline,
+                  timer_wheel& timers = default_timer_wheel(),
+                  executor_ref exec = {}) {
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      policy_.spin(
+          [this] { return available_.load(std::memory_order_relaxed) > 0; });
+
+      if (available_.fetch_sub(1, std::memory_order_acq_rel) > 0) {
+        co_return take();
+      }
+
+      co_await mutex_.lock();
+      awaitable_type awaitable{mutex_, exec};
+
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      if (signals_ != 0) {
+        --signals_;
+        co_return take();
+      }
+
+      if (timer_wheel::clock_type::now() >= deadline && withdraw()) {
+        co_return std::nullopt;
+      }
+
+      auto abort = std::make_unique<abort_type>();
+      auto& parked = *abort;
+
+      runque_timeout timeout{timers, abort_waiter(std::move(abort), {})};
+
+      waiters_.push(awaitable, policy_.get_wake_order());
+      waiters_.arm(awaitable, parked);
+
+      timeout.schedule(deadline);
+
+      co_await awaitable.park();
+      if (awaitable.expired()) {
+        co_return std::nullopt;
+      }
+
+      timeout.cancel();
+      co_return std::move(awaitable.result());
+    }
+
+    template<typename Rep, typename Period>
+    inline task<std::optional<value_type>>
+        get_for(std::chrono::duration<Rep, Period> const& timeout,
+                timer_wheel& timers = default_timer_wheel(),
+                executor_ref exec = {}) {
+      return get_until(
+          timer_wheel::clock_type::now() +
+              std::chrono::duration_cast<timer_wheel::duration>(timeout),
+          timers,
+          exec);
+    }
+
+    std::optional<value_type> try_get() {
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
+
+      auto available = available_.load(std::memory_order_relaxed);
+      while (available > 0) {
+        if (available_.compare_exchange_weak(available,
+                                             available - 1,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+          return take();
+        }
+      }
+
+      return {};
+    }
+
+    inline task<> put(value_type&& value) {
+      if (interrupted_.load(std::memory_order_acquire)) {
         throw interrupted{};
       }
 
-      if (waiters_ == nullptr) {
-        items_.push(std::forward<Tys>(args)...);
+      // count only items that made it into the queue, so a failed push
+      // never advertises an item that consumers would wait for forever
+      if constexpr (Bounded) {
+        while (!derived().try_push_item(value)) {
+          auto pushed = co_await space_.wait([this, &value]() noexcept {
+            return derived().try_push_item(value);
+          });
+
+          if (pushed) {
+            break;
+          }
+
+          if (interrupted_.load(std::memory_order_acquire)) {
+            throw interrupted{};
+          }
+        }
       }
       else {
-        awaken = pop_waiter();
+        derived().push_item(std::move(value));
+      }
+
+      if (available_.fetch_add(1, std::memory_order_acq_rel) >= 0) {
+        co_return;
+      }
+
+      awaitable_type* awaken{nullptr};
+
+      {
+        co_await mutex_.lock();
+        mutex_guard guard{mutex_, std::adopt_lock};
+
+        if (waiters_.empty()) {
+          ++signals_;
+        }
+        else {
+          awaken = waiters_.pop();
+        }
+      }
+
+      if (awaken != nullptr) {
+        awaken->resume_result(take());
       }
     }
 
-    if (awaken != nullptr) {
-      awaken->resume_result(std::forward<Tys>(args)...);
+    template<typename... Tys>
+    requires(std::is_constructible_v<value_type, Tys...>) inline task<> put(
+        Tys&&... args) {
+      co_await put(value_type{std::forward<Tys>(args)...});
     }
-  }
 
-  inline task<> interrupt() noexcept {
-    awaitable_type* waiters{nullptr};
+    // a bounded queue that fills up gets the items pushed so far published
+    // before the producer parks, so consumers can free the slots it needs
+    task<> put_many(std::span<value_type> values) {
+      if (values.empty()) {
+        co_return;
+      }
 
-    {
-      co_await mutex_.lock();
-      mutex_guard guard{mutex_, std::adopt_lock};
+      if (interrupted_.load(std::memory_order_acquire)) {
+        throw interrupted{};
+      }
 
-      interrupted_ = true;
-      waiters = std::exchange(waiters_, nullptr);
+      std::exception_ptr error{};
+      std::size_t pushed{0};
+      std::size_t published{0};
+
+      for (;;) {
+        try {
+          for (; pushed != values.size(); ++pushed) {
+            if constexpr (Bounded) {
+              if (!derived().try_push_item(values[pushed])) {
+                break;
+              }
+            }
+            else {
+              derived().push_item(std::move(values[pushed]));
+            }
+          }
+        }
+        catch (...) {
+          error = std::current_exception();
+        }
+
+        auto count = static_cast<std::ptrdiff_t>(pushed - published);
+        published = pushed;
+
+        auto parked = -available_.fetch_add(count, std::memory_order_acq_rel);
+        auto claimed = std::clamp(parked, std::ptrdiff_t{0}, count);
+
+        if (claimed != 0) {
+          waiter_list<awaitable_type> awaken{};
+
+          {
+            co_await mutex_.lock();
+            mutex_guard guard{mutex_, std::adopt_lock};
+
+            for (; claimed != 0; --claimed) {
+              if (waiters_.empty()) {
+                ++signals_;
+              }
+              else {
+                awaken.push(*waiters_.pop(), wake_order::fifo);
+              }
+            }
+          }
+
+          while (!awaken.empty()) {
+            awaken.pop()->resume_result(take());
+          }
+        }
+
+        if (error) {
+          std::rethrow_exception(error);
+        }
+
+        if constexpr (Bounded) {
+          if (pushed != values.size()) {
+            auto& value = values[pushed];
+            auto retried = co_await space_.wait([this, &value]() noexcept {
+              return derived().try_push_item(value);
+            });
+
+            if (retried) {
+              ++pushed;
+            }
+            else if (interrupted_.load(std::memory_order_acquire)) {
+              throw interrupted{};
+            }
+
+            continue;
+          }
+        }
+
+        co_return;
+      }
     }
 
-    auto exception = std::make_exception_ptr(interrupted{});
-    while (waiters != nullptr) {
-      auto next = waiters->get_next();
-      waiters->resume_exception(exception);
-      waiters = next;
+    inline task<> interrupt() noexcept {
+      awaitable_type* waiters{nullptr};
+
+      {
+        co_await mutex_.lock();
+        mutex_guard guard{mutex_, std::adopt_lock};
+
+        interrupted_.store(true, std::memory_order_release);
+        waiters = waiters_.release();
+      }
+
+      auto exception = std::make_exception_ptr(interrupted{});
+      while (waiters != nullptr) {
+        auto next = waiters->links().next_;
+        waiters->resume_exception(exception);
+        waiters = next;
+      }
+
+      if constexpr (Bounded) {
+        space_.open();
+      }
+    }
+
+    inline void set_wake_order(wake_order order) noexcept {
+      policy_.set_wake_order(order);
+    }
+
+    inline wake_order get_wake_order() const noexcept {
+      return policy_.get_wake_order();
+    }
+
+    inline void set_spin_limit(std::uint32_t limit) noexcept {
+      policy_.set_spin_limit(limit);
+    }
+
+    inline std::uint32_t get_spin_limit() const noexcept {
+      return policy_.get_spin_limit();
+    }
+
+  protected:
+    inline counted_runque() noexcept = default;
+    inline ~counted_runque() = default;
+
+  private:
+    inline Derived& derived() noexcept {
+      return static_cast<Derived&>(*this);
+    }
+
+    inline value_type take() noexcept {
+      auto item{derived().take_item()};
+      if constexpr (Bounded) {
+        space_.notify();
+      }
+
+      return item;
+    }
+
+    inline bool withdraw() noexcept {
+      auto available = available_.load(std::memory_order_relaxed);
+      while (available < 0) {
+        if (available_.compare_exchange_weak(available,
+                                             available + 1,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed)) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    // expires the waiter when error is null, fails it with error otherwise;
+    // a waiter a producer has already claimed is left for that producer
+    detached_task abort_waiter(std::unique_ptr<abort_type> abort,
+                               std::exception_ptr error) {
+      awaitable_type* awaken{nullptr};
+
+      {
+        co_await mutex_.lock();
+        mutex_guard guard{mutex_, std::adopt_lock};
+
+        awaken = abort->awaitable_;
+        if (awaken == nullptr) {
+          co_return;
+        }
+
+        if (!withdraw()) {
+          waiters_.disarm(*awaken);
+          co_return;
+        }
+
+        waiters_.erase(*awaken);
+      }
+
+      if (error != nullptr) {
+        awaken->resume_exception(error);
+      }
+      else {
+        awaken->resume_expired();
+      }
     }
+
+  private:
+    alignas(cache_line_size) std::atomic<std::ptrdiff_t> available_{0};
+    std::atomic<bool> interrupted_{false};
+
+    alignas(cache_line_size) waiter_list<awaitable_type> waiters_;
+    std::size_t signals_{0};
+
+    mutex mutex_;
+
+    park_policy policy_;
+
+    [[no_unique_address]] std::conditional_t<Bounded,
+                                             space_gate,
+                                             no_space_gate> space_;
+  };
+} // namespace detail
+
+template<synchronized_queuelike Queue>
+class runque<Queue, coro_thread_model>
+    : public detail::counted_runque<runque<Queue, coro_thread_model>,
+                                    typename Queue::value_type,
+                                    bounded_queuelike<Queue>> {
+private:
+  using queue_type = Queue;
+
+public:
+  using thread_model = coro_thread_model;
+  using value_type = typename queue_type::value_type;
+  using allocator_type = typename queue_type::allocator_type;
+
+public:
+  inline runque(allocator_type const& alloc = allocator_type{})
+      : items_{alloc} {
+  }
+
+  inline queue_type& get_queue() noexcept {
+    return items_;
   }
 
 private:
-  inline awaitable_type* pop_waiter() noexcept {
-    auto awaken{waiters_};
-    waiters_ = awaken->get_next();
+  inline void push_item(value_type&& value) {
+    items_.push(std::move(value));
+  }
 
-    return awaken;
+  inline bool try_push_item(value_type& value) noexcept
+      requires(bounded_queuelike<queue_type>) {
+    return items_.try_push(std::move(value));
+  }
+
+  inline value_type take_item() noexcept {
+    return items_.pop();
   }
 
 private:
-  awaitable_type* waiters_{nullptr};
   queue_type items_;
 
-  bool interrupted_{false};
-
-  mutex mutex_;
+  friend detail::
+      counted_runque<runque, value_type, bounded_queuelike<queue_type>>;
 };
 
 template<typename Order,
@@ -446,6 +2983,55 @@ struct make_runque<priority_order, Mtm, Ty, Alloc, Less> {
   using type = runque<priority_runque_queue<Ty, Alloc, Less>, Mtm>;
 };
 
+template<typename Ty, typename Mtm, typename Alloc, typename Key>
+struct make_runque<keyed_priority_order, Mtm, Ty, Alloc, Key> {
+  using type = runque<keyed_priority_runque_queue<Ty, Key, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Key, typename Less>
+struct make_runque<keyed_priority_order, Mtm, Ty, Alloc, Key, Less> {
+  using type = runque<keyed_priority_runque_queue<Ty, Key, Alloc, Less>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Priority>
+struct make_runque<bucket_priority_order, Mtm, Ty, Alloc, Priority> {
+  using type = runque<bucket_priority_runque_queue<Ty, Priority, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<edf_order, Mtm, Ty, Alloc> {
+  using type = runque<edf_runque_queue<Ty, member_deadline, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Deadline>
+struct make_runque<edf_order, Mtm, Ty, Alloc, Deadline> {
+  using type = runque<edf_runque_queue<Ty, Deadline, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Key>
+struct make_runque<fair_order, Mtm, Ty, Alloc, Key> {
+  using type = runque<fair_runque_queue<Ty, Key, Alloc>, Mtm>;
+};
+
+template<typename Ty,
+         typename Mtm,
+         typename Alloc,
+         typename Key,
+         typename Cost>
+struct make_runque<fair_order, Mtm, Ty, Alloc, Key, Cost> {
+  using type = runque<fair_runque_queue<Ty, Key, Alloc, Cost>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<reservation_order, Mtm, Ty, Alloc> {
+  using type = runque<reservation_runque_queue<Ty, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Priority>
+struct make_runque<aging_priority_order, Mtm, Ty, Alloc, Priority> {
+  using type = runque<aging_priority_runque_queue<Ty, Priority, Alloc>, Mtm>;
+};
+
 template<typename Ty, typename Mtm, typename Alloc>
 struct make_runque<fifo_order, Mtm, Ty, Alloc> {
   using type = runque<fifo_runque_queue<Ty, Alloc>, Mtm>;
@@ -456,6 +3042,21 @@ struct make_runque<lifo_order, Mtm, Ty, Alloc> {
   using type = runque<lifo_runque_queue<Ty, Alloc>, Mtm>;
 };
 
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<mpmc_fifo_order, Mtm, Ty, Alloc> {
+  using type = runque<mpmc_runque_queue<Ty, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc>
+struct make_runque<relaxed_priority_order, Mtm, Ty, Alloc> {
+  using type = runque<relaxed_priority_runque_queue<Ty, Alloc>, Mtm>;
+};
+
+template<typename Ty, typename Mtm, typename Alloc, typename Less>
+struct make_runque<relaxed_priority_order, Mtm, Ty, Alloc, Less> {
+  using type = runque<relaxed_priority_runque_queue<Ty, Alloc, Less>, Mtm>;
+};
+
 template<typename Order,
          typename Mtm,
          typename Ty,
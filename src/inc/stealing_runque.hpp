@@ -0,0 +1,393 @@
+#pragma once
+
+#include "runque.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+
+namespace frq {
+namespace detail {
+  template<typename Ty>
+  struct steal_slot {
+    std::atomic<bool> full_{false};
+    alignas(Ty) std::array<std::byte, sizeof(Ty)> storage_;
+  };
+
+  template<runnable Ty, typename Alloc, std::size_t Capacity>
+  class steal_deque {
+  public:
+    static_assert(std::has_single_bit(Capacity));
+
+    using value_type = Ty;
+    using slot_type = steal_slot<value_type>;
+    using allocator_type = rebind_alloc_t<Alloc, slot_type>;
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    static constexpr std::int64_t mask = Capacity - 1;
+
+  public:
+    explicit inline steal_deque(allocator_type const& alloc)
+        : alloc_{alloc}
+        , slots_{alloc_traits::allocate(alloc_, Capacity)} {
+      for (std::size_t i = 0; i < Capacity; ++i) {
+        alloc_traits::construct(alloc_, slots_ + i);
+      }
+    }
+
+    steal_deque(steal_deque const&) = delete;
+    steal_deque(steal_deque&&) = delete;
+
+    steal_deque& operator=(steal_deque const&) = delete;
+    steal_deque& operator=(steal_deque&&) = delete;
+
+    inline ~steal_deque() {
+      while (pop()) {
+      }
+
+      for (std::size_t i = 0; i < Capacity; ++i) {
+        alloc_traits::destroy(alloc_, slots_ + i);
+      }
+
+      alloc_traits::deallocate(alloc_, slots_, Capacity);
+    }
+
+    bool push(value_type&& value) noexcept {
+      auto bottom = bottom_.load(std::memory_order_relaxed);
+      auto top = top_.load(std::memory_order_acquire);
+
+      auto& slot = slots_[bottom & mask];
+      if (bottom - top >= static_cast<std::int64_t>(Capacity) ||
+          slot.full_.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      new (slot.storage_.data()) value_type{std::move(value)};
+      slot.full_.store(true, std::memory_order_relaxed);
+
+      bottom_.store(bottom + 1, std::memory_order_release);
+      return true;
+    }
+
+    std::optional<value_type> pop() noexcept {
+      auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+      bottom_.store(bottom, std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto top = top_.load(std::memory_order_relaxed);
+
+      if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return {};
+      }
+
+      if (top == bottom) {
+        auto won = top_.compare_exchange_strong(top,
+                                                top + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+
+        if (!won) {
+          return {};
+        }
+      }
+
+      return take(slots_[bottom & mask]);
+    }
+
+    std::optional<value_type> steal() noexcept {
+      auto top = top_.load(std::memory_order_acquire);
+
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto bottom = bottom_.load(std::memory_order_acquire);
+
+      if (top >= bottom ||
+          !top_.compare_exchange_strong(top,
+                                        top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        return {};
+      }
+
+      return take(slots_[top & mask]);
+    }
+
+  private:
+    static std::optional<value_type> take(slot_type& slot) noexcept {
+      auto item =
+          std::launder(reinterpret_cast<value_type*>(slot.storage_.data()));
+
+      std::optional<value_type> result{std::move(*item)};
+      item->~value_type();
+
+      slot.full_.store(false, std::memory_order_release);
+      return result;
+    }
+
+  private:
+    [[no_unique_address]] allocator_type alloc_;
+    slot_type* slots_;
+
+    alignas(cache_line_size) std::atomic<std::int64_t> top_{0};
+    alignas(cache_line_size) std::atomic<std::int64_t> bottom_{0};
+  };
+} // namespace detail
+
+template<runnable Ty,
+         typename Alloc = std::allocator<Ty>,
+         std::size_t Workers = 64,
+         std::size_t Capacity = 256>
+class stealing_runque
+    : public detail::counted_runque<
+          stealing_runque<Ty, Alloc, Workers, Capacity>,
+          Ty> {
+public:
+  using thread_model = coro_thread_model;
+  using value_type = Ty;
+  using allocator_type = Alloc;
+
+private:
+  using deque_type = detail::steal_deque<value_type, allocator_type, Capacity>;
+  using deque_alloc_type = detail::rebind_alloc_t<allocator_type, deque_type>;
+  using deque_alloc_traits = std::allocator_traits<deque_alloc_type>;
+
+  struct worker {
+    std::atomic<bool> attached_{false};
+    std::atomic<deque_type*> deque_{nullptr};
+  };
+
+  struct binding {
+    stealing_runque* owner_{nullptr};
+    std::size_t index_{0};
+  };
+
+public:
+  class worker_scope {
+  public:
+    inline worker_scope(worker_scope&& other) noexcept
+        : owner_{std::exchange(other.owner_, nullptr)}
+        , index_{other.index_}
+        , previous_{other.previous_} {
+    }
+
+    worker_scope(worker_scope const&) = delete;
+
+    worker_scope& operator=(worker_scope&&) = delete;
+    worker_scope& operator=(worker_scope const&) = delete;
+
+    inline ~worker_scope() {
+      if (owner_ != nullptr) {
+        owner_->detach(index_, previous_);
+      }
+    }
+
+    inline bool attached() const noexcept {
+      return owner_ != nullptr;
+    }
+
+  private:
+    friend stealing_runque;
+
+    inline worker_scope(stealing_runque* owner,
+                        std::size_t index,
+                        binding previous) noexcept
+        : owner_{owner}
+        , index_{index}
+        , previous_{previous} {
+    }
+
+  private:
+    stealing_runque* owner_;
+    std::size_t index_;
+    binding previous_;
+  };
+
+public:
+  inline stealing_runque(allocator_type const& alloc = allocator_type{})
+      : alloc_{alloc}
+      , injected_{alloc}
+      , spilled_{alloc} {
+  }
+
+  stealing_runque(stealing_runque const&) = delete;
+  stealing_runque(stealing_runque&&) = delete;
+
+  stealing_runque& operator=(stealing_runque const&) = delete;
+  stealing_runque& operator=(stealing_runque&&) = delete;
+
+  inline ~stealing_runque() {
+    deque_alloc_type alloc{alloc_};
+    for (auto& w : workers_) {
+      if (auto deque = w.deque_.load(std::memory_order_relaxed);
+          deque != nullptr) {
+        deque_alloc_traits::destroy(alloc, deque);
+        deque_alloc_traits::deallocate(alloc, deque, 1);
+      }
+    }
+  }
+
+  worker_scope attach() {
+    for (std::size_t i = 0; i < Workers; ++i) {
+      auto& w = workers_[i];
+
+      auto expected{false};
+      if (w.attached_.compare_exchange_strong(
+              expected, true, std::memory_order_acquire)) {
+        try {
+          ensure_deque(w);
+        }
+        catch (...) {
+          w.attached_.store(false, std::memory_order_release);
+          throw;
+        }
+
+        return worker_scope{
+            this, i, std::exchange(current_, binding{this, i})};
+      }
+    }
+
+    return worker_scope{nullptr, 0, {}};
+  }
+
+private:
+  void ensure_deque(worker& w) {
+    if (w.deque_.load(std::memory_order_relaxed) == nullptr) {
+      deque_alloc_type alloc{alloc_};
+
+      auto deque = deque_alloc_traits::allocate(alloc, 1);
+      try {
+        deque_alloc_traits::construct(
+            alloc, deque, typename deque_type::allocator_type{alloc_});
+      }
+      catch (...) {
+        deque_alloc_traits::deallocate(alloc, deque, 1);
+        throw;
+      }
+
+      w.deque_.store(deque, std::memory_order_release);
+    }
+  }
+
+  inline void detach(std::size_t index, binding previous) noexcept {
+    if (current_.owner_ == this && current_.index_ == index) {
+      current_ = previous;
+    }
+
+    workers_[index].attached_.store(false, std::memory_order_release);
+  }
+
+  inline deque_type* local() const noexcept {
+    if (current_.owner_ != this) {
+      return nullptr;
+    }
+
+    return workers_[current_.index_].deque_.load(std::memory_order_relaxed);
+  }
+
+  // workers produce as well as consume, so parking one on a full queue
+  // could leave nobody to drain it; a full injection ring spills instead
+  inline void push_item(value_type&& value) {
+    auto deque = local();
+    if (deque != nullptr && deque->push(std::move(value))) {
+      return;
+    }
+
+    if (injected_.try_push(std::move(value))) {
+      return;
+    }
+
+    std::lock_guard guard{spill_lock_};
+    spilled_.push_back(std::move(value));
+    spilled_size_.fetch_add(1, std::memory_order_release);
+  }
+
+  // spilled items are older than those in the ring, so they go first
+  inline std::optional<value_type> try_take_spilled() noexcept {
+    if (spilled_size_.load(std::memory_order_acquire) == 0) {
+      return {};
+    }
+
+    std::unique_lock lock{spill_lock_, std::try_to_lock};
+    if (!lock.owns_lock() || spilled_.empty()) {
+      return {};
+    }
+
+    std::optional<value_type> result{std::move(spilled_.front())};
+    spilled_.pop_front();
+    spilled_size_.fetch_sub(1, std::memory_order_relaxed);
+
+    return result;
+  }
+
+  std::optional<value_type> try_take() noexcept {
+    auto deque = local();
+    if (deque != nullptr) {
+      if (auto result = deque->pop(); result) {
+        return result;
+      }
+    }
+
+    if (auto result = try_take_spilled(); result) {
+      return result;
+    }
+
+    if (auto result = injected_.try_pop(); result) {
+      return result;
+    }
+
+    auto start = deque != nullptr
+                     ? current_.index_ + 1
+                     : victim_.fetch_add(1, std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < Workers; ++i) {
+      auto victim = workers_[(start + i) % Workers].deque_.load(
+          std::memory_order_acquire);
+
+      if (victim != nullptr && victim != deque) {
+        if (auto result = victim->steal(); result) {
+          return result;
+        }
+      }
+    }
+
+    return {};
+  }
+
+  inline value_type take_item() noexcept {
+    for (;;) {
+      if (auto result = try_take(); result) {
+        return std::move(*result);
+      }
+
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  static inline thread_local binding current_{};
+
+  [[no_unique_address]] allocator_type alloc_;
+
+  std::array<worker, Workers> workers_{};
+  mpmc_runque_queue<value_type, allocator_type> injected_;
+
+  std::mutex spill_lock_;
+  std::deque<value_type, allocator_type> spilled_;
+  std::atomic<std::size_t> spilled_size_{0};
+
+  std::atomic<std::size_t> victim_{0};
+
+  friend detail::counted_runque<stealing_runque, value_type>;
+};
+
+} // namespace frq
@@ -171,9 +171,14 @@ sync_waited<Ret> make_sync_wait(Ty&& awaitable) {
   }
 }
 
+template<typename Ty,
+         typename Ret = decltype(std::declval<Ty&&>().await_resume())>
+using sync_wait_result_t = std::conditional_t<std::is_rvalue_reference_v<Ret>,
+                                              std::remove_cvref_t<Ret>,
+                                              Ret>;
+
 template<typename Ty>
-auto sync_wait(Ty&& awaitable)
-    -> decltype(std::forward<Ty>(awaitable).await_resume()) {
+auto sync_wait(Ty&& awaitable) -> sync_wait_result_t<Ty> {
   auto waited = make_sync_wait(std::forward<Ty>(awaitable));
   return waited.execute();
 }
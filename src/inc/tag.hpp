@@ -2,10 +2,19 @@
 
 #include "utility.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <compare>
 #include <concepts>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <tuple>
 #include <vector>
 
@@ -92,6 +101,386 @@ private:
 template<typename... Tys>
 using stag_t = stag<static_cast<std::uint8_t>(sizeof...(Tys)), Tys...>;
 
+struct wildcard_t {
+  constexpr bool operator==(wildcard_t const&) const noexcept = default;
+};
+
+constexpr wildcard_t wildcard{};
+
+template<typename Ty>
+struct tag_formatter {};
+
+template<typename Ty>
+concept formattable_tag_value =
+    requires(char* out, char const* in, Ty& value) {
+  { tag_formatter<Ty>::to_chars(out, out, std::as_const(value)) }
+  ->std::same_as<std::to_chars_result>;
+
+  { tag_formatter<Ty>::from_chars(in, in, value) }
+  ->std::same_as<std::from_chars_result>;
+};
+
+namespace detail {
+  inline std::to_chars_result
+      copy_chars(char* first, char* last, std::string_view value) noexcept {
+    if (static_cast<std::size_t>(last - first) < value.size()) {
+      return {last, std::errc::value_too_large};
+    }
+
+    return {std::copy(value.begin(), value.end(), first), std::errc{}};
+  }
+} // namespace detail
+
+template<typename Ty>
+requires(std::is_arithmetic_v<Ty> && !std::is_same_v<Ty, bool>)
+struct tag_formatter<Ty> {
+  static inline std::to_chars_result
+      to_chars(char* first, char* last, Ty value) noexcept {
+    return std::to_chars(first, last, value);
+  }
+
+  static inline std::from_chars_result
+      from_chars(char const* first, char const* last, Ty& value) noexcept {
+    return std::from_chars(first, last, value);
+  }
+};
+
+template<>
+struct tag_formatter<std::string_view> {
+  static inline std::to_chars_result
+      to_chars(char* first, char* last, std::string_view value) noexcept {
+    return detail::copy_chars(first, last, value);
+  }
+
+  static inline std::from_chars_result from_chars(
+      char const* first, char const* last, std::string_view& value) noexcept {
+    value = std::string_view{first, static_cast<std::size_t>(last - first)};
+    return {last, std::errc{}};
+  }
+};
+
+template<typename Traits, typename Alloc>
+struct tag_formatter<std::basic_string<char, Traits, Alloc>> {
+  using value_type = std::basic_string<char, Traits, Alloc>;
+
+  static inline std::to_chars_result
+      to_chars(char* first, char* last, value_type const& value) noexcept {
+    return detail::copy_chars(first, last, {value.data(), value.size()});
+  }
+
+  static inline std::from_chars_result
+      from_chars(char const* first, char const* last, value_type& value) {
+    value.assign(first, last);
+    return {last, std::errc{}};
+  }
+};
+
+template<>
+struct tag_formatter<wildcard_t> {
+  static inline std::to_chars_result
+      to_chars(char* first, char* last, wildcard_t /*unused*/) noexcept {
+    return detail::copy_chars(first, last, "*");
+  }
+
+  static inline std::from_chars_result from_chars(
+      char const* first, char const* last, wildcard_t& /*unused*/) noexcept {
+    if (std::string_view{first, static_cast<std::size_t>(last - first)} !=
+        "*") {
+      return {first, std::errc::invalid_argument};
+    }
+
+    return {last, std::errc{}};
+  }
+};
+
+namespace detail {
+  template<formattable_tag_value Ty>
+  std::string format_tag_value(Ty const& value) {
+    std::string result(16, '\0');
+    while (true) {
+      auto [ptr, ec] = tag_formatter<Ty>::to_chars(
+          result.data(), result.data() + result.size(), value);
+
+      if (ec == std::errc{}) {
+        result.resize(static_cast<std::size_t>(ptr - result.data()));
+        return result;
+      }
+
+      result.resize(result.size() * 2);
+    }
+  }
+} // namespace detail
+
+enum class tag_type_code : std::uint8_t {
+  wildcard = 0x00,
+  int8 = 0x01,
+  int16 = 0x02,
+  int32 = 0x03,
+  int64 = 0x04,
+  uint8 = 0x05,
+  uint16 = 0x06,
+  uint32 = 0x07,
+  uint64 = 0x08,
+  float32 = 0x09,
+  float64 = 0x0a,
+  string = 0x0b,
+  interval = 0x0c
+};
+
+class tag_sink {
+public:
+  virtual ~tag_sink() {
+  }
+
+  virtual void write(char const* data, std::size_t size) = 0;
+};
+
+template<typename Ty>
+struct tag_codec {};
+
+template<typename Ty>
+concept encodable_tag_value =
+    requires(tag_sink& sink, char const* in, Ty& value) {
+  { tag_codec<Ty>::type_code }
+  ->std::convertible_to<tag_type_code>;
+
+  tag_codec<Ty>::encode(sink, std::as_const(value));
+
+  { tag_codec<Ty>::decode(in, in, value) }
+  ->std::same_as<std::from_chars_result>;
+};
+
+namespace detail {
+  template<typename Sink>
+  void encode_varint(Sink& sink, std::uint64_t value) {
+    std::array<char, 10> buffer{};
+
+    std::size_t size{0};
+    for (; value >= 0x80U; value >>= 7U) {
+      buffer[size++] = static_cast<char>(value | 0x80U);
+    }
+
+    buffer[size++] = static_cast<char>(value);
+    sink.write(buffer.data(), size);
+  }
+
+  inline std::from_chars_result decode_varint(char const* first,
+                                              char const* last,
+                                              std::uint64_t& value) noexcept {
+    value = 0;
+    for (unsigned shift = 0; first != last && shift < 64; shift += 7) {
+      auto byte = static_cast<std::uint8_t>(*first++);
+      value |= static_cast<std::uint64_t>(byte & 0x7fU) << shift;
+
+      if ((byte & 0x80U) == 0) {
+        return {first, std::errc{}};
+      }
+    }
+
+    return {first, std::errc::invalid_argument};
+  }
+
+  template<typename Sink, std::unsigned_integral Ty>
+  void encode_fixed(Sink& sink, Ty value) {
+    std::array<char, sizeof(Ty)> buffer{};
+    for (auto& byte : buffer) {
+      byte = static_cast<char>(value & 0xffU);
+      value = static_cast<Ty>(value >> 8U);
+    }
+
+    sink.write(buffer.data(), buffer.size());
+  }
+
+  template<std::unsigned_integral Ty>
+  std::from_chars_result
+      decode_fixed(char const* first, char const* last, Ty& value) noexcept {
+    if (static_cast<std::size_t>(last - first) < sizeof(Ty)) {
+      return {last, std::errc::invalid_argument};
+    }
+
+    value = 0;
+    for (std::size_t i = 0; i < sizeof(Ty); ++i) {
+      value |= static_cast<Ty>(static_cast<Ty>(static_cast<std::uint8_t>(
+                                   first[i]))
+                               << (8U * i));
+    }
+
+    return {first + sizeof(Ty), std::errc{}};
+  }
+
+  template<typename Sink>
+  void encode_bytes(Sink& sink, std::string_view value) {
+    encode_varint(sink, value.size());
+    sink.write(value.data(), value.size());
+  }
+
+  inline std::from_chars_result decode_bytes(char const* first,
+                                             char const* last,
+                                             std::string_view& value) noexcept {
+    std::uint64_t size{};
+    auto result = decode_varint(first, last, size);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    if (static_cast<std::uint64_t>(last - result.ptr) < size) {
+      return {last, std::errc::invalid_argument};
+    }
+
+    value = std::string_view{result.ptr, static_cast<std::size_t>(size)};
+    return {result.ptr + size, std::errc{}};
+  }
+
+  template<std::integral Ty>
+  constexpr tag_type_code integer_type_code() noexcept {
+    constexpr auto base = std::is_signed_v<Ty> ? tag_type_code::int8
+                                               : tag_type_code::uint8;
+
+    return static_cast<tag_type_code>(static_cast<std::uint8_t>(base) +
+                                      std::countr_zero(sizeof(Ty)));
+  }
+
+  template<typename Sink, encodable_tag_value Ty>
+  void encode_tag_level(Sink& sink, Ty const& value) {
+    auto code = static_cast<char>(tag_codec<Ty>::type_code);
+    sink.write(&code, 1);
+
+    tag_codec<Ty>::encode(sink, value);
+  }
+} // namespace detail
+
+template<std::integral Ty>
+requires(!std::is_same_v<Ty, bool> && sizeof(Ty) <= 8) struct tag_codec<Ty> {
+  static constexpr tag_type_code type_code = detail::integer_type_code<Ty>();
+
+  template<typename Sink>
+  static inline void encode(Sink& sink, Ty value) {
+    if constexpr (std::is_signed_v<Ty>) {
+      auto wide = static_cast<std::int64_t>(value);
+      detail::encode_varint(sink,
+                            (static_cast<std::uint64_t>(wide) << 1U) ^
+                                static_cast<std::uint64_t>(wide >> 63U));
+    }
+    else {
+      detail::encode_varint(sink, value);
+    }
+  }
+
+  static inline std::from_chars_result
+      decode(char const* first, char const* last, Ty& value) noexcept {
+    std::uint64_t raw{};
+    auto result = detail::decode_varint(first, last, raw);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    if constexpr (std::is_signed_v<Ty>) {
+      auto wide = static_cast<std::int64_t>(raw >> 1U) ^
+                  -static_cast<std::int64_t>(raw & 1U);
+      if (wide < std::numeric_limits<Ty>::min() ||
+          wide > std::numeric_limits<Ty>::max()) {
+        return {first, std::errc::result_out_of_range};
+      }
+
+      value = static_cast<Ty>(wide);
+    }
+    else {
+      if (raw > std::numeric_limits<Ty>::max()) {
+        return {first, std::errc::result_out_of_range};
+      }
+
+      value = static_cast<Ty>(raw);
+    }
+
+    return result;
+  }
+};
+
+template<std::floating_point Ty>
+requires(std::numeric_limits<Ty>::is_iec559 &&
+         (sizeof(Ty) == 4 || sizeof(Ty) == 8)) struct tag_codec<Ty> {
+  using bits_type =
+      std::conditional_t<sizeof(Ty) == 4, std::uint32_t, std::uint64_t>;
+
+  static constexpr tag_type_code type_code =
+      sizeof(Ty) == 4 ? tag_type_code::float32 : tag_type_code::float64;
+
+  template<typename Sink>
+  static inline void encode(Sink& sink, Ty value) {
+    // -0.0 == +0.0, so both must encode (and fingerprint) the same
+    if (value == Ty{}) {
+      value = Ty{};
+    }
+
+    detail::encode_fixed(sink, std::bit_cast<bits_type>(value));
+  }
+
+  static inline std::from_chars_result
+      decode(char const* first, char const* last, Ty& value) noexcept {
+    bits_type bits{};
+    auto result = detail::decode_fixed(first, last, bits);
+    if (result.ec == std::errc{}) {
+      value = std::bit_cast<Ty>(bits);
+    }
+
+    return result;
+  }
+};
+
+template<>
+struct tag_codec<std::string_view> {
+  static constexpr tag_type_code type_code = tag_type_code::string;
+
+  template<typename Sink>
+  static inline void encode(Sink& sink, std::string_view value) {
+    detail::encode_bytes(sink, value);
+  }
+
+  static inline std::from_chars_result decode(
+      char const* first, char const* last, std::string_view& value) noexcept {
+    return detail::decode_bytes(first, last, value);
+  }
+};
+
+template<typename Traits, typename Alloc>
+struct tag_codec<std::basic_string<char, Traits, Alloc>> {
+  using value_type = std::basic_string<char, Traits, Alloc>;
+
+  static constexpr tag_type_code type_code = tag_type_code::string;
+
+  template<typename Sink>
+  static inline void encode(Sink& sink, value_type const& value) {
+    detail::encode_bytes(sink, {value.data(), value.size()});
+  }
+
+  static inline std::from_chars_result
+      decode(char const* first, char const* last, value_type& value) {
+    std::string_view bytes{};
+    auto result = detail::decode_bytes(first, last, bytes);
+    if (result.ec == std::errc{}) {
+      value.assign(bytes.data(), bytes.size());
+    }
+
+    return result;
+  }
+};
+
+template<>
+struct tag_codec<wildcard_t> {
+  static constexpr tag_type_code type_code = tag_type_code::wildcard;
+
+  template<typename Sink>
+  static inline void encode(Sink& /*unused*/, wildcard_t /*unused*/) {
+  }
+
+  static inline std::from_chars_result
+      decode(char const* first,
+             char const* /*unused*/,
+             wildcard_t& /*unused*/) noexcept {
+    return {first, std::errc{}};
+  }
+};
+
 class dtag_node {
 public:
   virtual ~dtag_node() {
@@ -100,6 +489,18 @@ public:
   virtual std::size_t hash() const noexcept = 0;
   virtual bool equal(dtag_node const& other) const noexcept = 0;
   virtual std::string get_string() const = 0;
+
+  virtual std::to_chars_result to_chars(char* first, char* last) const {
+    return detail::copy_chars(first, last, get_string());
+  }
+
+  virtual void encode(tag_sink& sink) const {
+    detail::encode_tag_level(sink, get_string());
+  }
+
+  virtual bool wildcard() const noexcept {
+    return false;
+  }
 };
 
 using dtag_node_ptr = std::shared_ptr<dtag_node>;
@@ -138,14 +539,41 @@ namespace detail {
     }
 
     std::string get_string() const override {
-      using namespace std;
-      return to_string(value_);
+      if constexpr (formattable_tag_value<value_type>) {
+        return format_tag_value(value_);
+      }
+      else {
+        using namespace std;
+        return to_string(value_);
+      }
+    }
+
+    std::to_chars_result to_chars(char* first, char* last) const override {
+      if constexpr (formattable_tag_value<value_type>) {
+        return tag_formatter<value_type>::to_chars(first, last, value_);
+      }
+      else {
+        return dtag_node::to_chars(first, last);
+      }
+    }
+
+    void encode(tag_sink& sink) const override {
+      if constexpr (encodable_tag_value<value_type>) {
+        encode_tag_level(sink, value_);
+      }
+      else {
+        dtag_node::encode(sink);
+      }
     }
 
     inline Ty const& value() const override {
       return value_;
     }
 
+    bool wildcard() const noexcept override {
+      return std::is_same_v<value_type, wildcard_t>;
+    }
+
   private:
     [[no_unique_address]] hash_compare_type hash_cmp_;
     Ty value_;
@@ -189,6 +617,18 @@ public:
     return tag_node_->get_string();
   }
 
+  inline std::to_chars_result to_chars(char* first, char* last) const {
+    return tag_node_->to_chars(first, last);
+  }
+
+  inline void encode(tag_sink& sink) const {
+    tag_node_->encode(sink);
+  }
+
+  inline bool wildcard() const noexcept {
+    return tag_node_->wildcard();
+  }
+
   inline bool operator==(dtag_value const& rhs) const noexcept {
     return tag_node_->equal(*rhs.tag_node_);
   }
@@ -234,6 +674,185 @@ concept tag_iterator = requires(Ty i) {
   ->std::convertible_to<bool>;
 };
 
+template<typename Ty>
+class interval {
+public:
+  using value_type = Ty;
+
+public:
+  constexpr inline interval() = default;
+
+  constexpr inline interval(value_type lower, value_type upper) noexcept(
+      std::is_nothrow_move_constructible_v<value_type>)
+      : lower_{std::move(lower)}
+      , upper_{std::move(upper)} {
+    assert(!(upper_ < lower_));
+  }
+
+  constexpr inline value_type const& lower() const noexcept {
+    return lower_;
+  }
+
+  constexpr inline value_type const& upper() const noexcept {
+    return upper_;
+  }
+
+  constexpr inline bool overlaps(interval const& other) const noexcept {
+    return lower_ < other.upper_ && other.lower_ < upper_;
+  }
+
+  constexpr auto operator<=>(interval const&) const = default;
+
+private:
+  value_type lower_{};
+  value_type upper_{};
+};
+
+template<formattable_tag_value Ty>
+struct tag_formatter<interval<Ty>> {
+  using value_type = interval<Ty>;
+
+  static std::to_chars_result
+      to_chars(char* first, char* last, value_type const& value) {
+    auto result = detail::copy_chars(first, last, "[");
+    if (result.ec == std::errc{}) {
+      result = tag_formatter<Ty>::to_chars(result.ptr, last, value.lower());
+    }
+
+    if (result.ec == std::errc{}) {
+      result = detail::copy_chars(result.ptr, last, ",");
+    }
+
+    if (result.ec == std::errc{}) {
+      result = tag_formatter<Ty>::to_chars(result.ptr, last, value.upper());
+    }
+
+    if (result.ec == std::errc{}) {
+      result = detail::copy_chars(result.ptr, last, ")");
+    }
+
+    return result;
+  }
+
+  static std::from_chars_result
+      from_chars(char const* first, char const* last, value_type& value) {
+    if (last - first < 2 || *first != '[' || *(last - 1) != ')') {
+      return {first, std::errc::invalid_argument};
+    }
+
+    auto separator = std::find(first + 1, last - 1, ',');
+    if (separator == last - 1) {
+      return {separator, std::errc::invalid_argument};
+    }
+
+    Ty lower{};
+    auto result = parse_bound(first + 1, separator, lower);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    Ty upper{};
+    result = parse_bound(separator + 1, last - 1, upper);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    if (upper < lower) {
+      return {first, std::errc::invalid_argument};
+    }
+
+    value = value_type{std::move(lower), std::move(upper)};
+    return {last, std::errc{}};
+  }
+
+private:
+  static inline std::from_chars_result
+      parse_bound(char const* first, char const* last, Ty& value) {
+    auto result = tag_formatter<Ty>::from_chars(first, last, value);
+    if (result.ec == std::errc{} && result.ptr != last) {
+      return {result.ptr, std::errc::invalid_argument};
+    }
+
+    return result;
+  }
+};
+
+template<encodable_tag_value Ty>
+struct tag_codec<interval<Ty>> {
+  using value_type = interval<Ty>;
+
+  static constexpr tag_type_code type_code = tag_type_code::interval;
+
+  template<typename Sink>
+  static inline void encode(Sink& sink, value_type const& value) {
+    auto code = static_cast<char>(tag_codec<Ty>::type_code);
+    sink.write(&code, 1);
+
+    tag_codec<Ty>::encode(sink, value.lower());
+    tag_codec<Ty>::encode(sink, value.upper());
+  }
+
+  static std::from_chars_result
+      decode(char const* first, char const* last, value_type& value) {
+    if (first == last ||
+        static_cast<tag_type_code>(*first) != tag_codec<Ty>::type_code) {
+      return {first, std::errc::invalid_argument};
+    }
+
+    Ty lower{};
+    auto result = tag_codec<Ty>::decode(first + 1, last, lower);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    Ty upper{};
+    result = tag_codec<Ty>::decode(result.ptr, last, upper);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    if (upper < lower) {
+      return {first, std::errc::invalid_argument};
+    }
+
+    value = value_type{std::move(lower), std::move(upper)};
+    return result;
+  }
+};
+
+template<typename Ty>
+struct is_interval : std::false_type {};
+
+template<typename Ty>
+struct is_interval<interval<Ty>> : std::true_type {};
+
+template<typename Ty>
+concept interval_key = is_interval<Ty>::value;
+
+template<typename Ty>
+struct tag_domain {
+  static constexpr bool is_bounded = false;
+};
+
+template<typename Ty, std::size_t Size>
+struct bounded_tag_domain {
+  static constexpr bool is_bounded = true;
+  static constexpr std::size_t size_v = Size;
+
+  static constexpr inline std::size_t index(Ty const& value) noexcept {
+    return static_cast<std::size_t>(value);
+  }
+};
+
+template<typename Ty>
+concept bounded_tag_key = tag_domain<Ty>::is_bounded && requires(Ty v) {
+  { tag_domain<Ty>::size_v }
+  ->std::convertible_to<std::size_t>;
+
+  { tag_domain<Ty>::index(v) }
+  noexcept->std::convertible_to<std::size_t>;
+};
+
 template<typename Alloc = std::allocator<dtag_node>>
 class dtag {
 public:
@@ -527,6 +1146,19 @@ public:
     return next_type{*tag_, last() ? level_ : level_ + 1};
   }
 
+  inline dtag_view at(size_type level) const noexcept {
+    assert(level < tag_->size());
+    return dtag_view{*tag_, level};
+  }
+
+  inline tag_type const& tag() const noexcept {
+    return *tag_;
+  }
+
+  inline size_type level() const noexcept {
+    return level_;
+  }
+
   inline bool last() const noexcept {
     return level_ == tag_->size() - 1;
   }
@@ -585,6 +1217,23 @@ struct hash<frq::dtag_value> {
   }
 };
 
+template<typename Ty>
+struct hash<frq::interval<Ty>> {
+  inline size_t operator()(frq::interval<Ty> const& value) const noexcept {
+    auto seed = hash<Ty>{}(value.lower());
+    return seed ^ (hash<Ty>{}(value.upper()) + 0x9e3779b9 + (seed << 6U) +
+                   (seed >> 2U));
+  }
+};
+
+template<>
+struct hash<frq::wildcard_t> {
+  constexpr inline size_t
+      operator()(frq::wildcard_t const& /*unused*/) const noexcept {
+    return 0;
+  }
+};
+
 template<>
 struct hash<frq::etag_value> {
   constexpr inline size_t
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "tag.hpp"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace frq {
+
+namespace detail {
+  class buffer_sink final : public tag_sink {
+  public:
+    inline buffer_sink(char* first, char* last) noexcept
+        : current_{first}
+        , last_{last} {
+    }
+
+    void write(char const* data, std::size_t size) override {
+      if (overflow_ || static_cast<std::size_t>(last_ - current_) < size) {
+        overflow_ = true;
+        return;
+      }
+
+      std::memcpy(current_, data, size);
+      current_ += size;
+    }
+
+    inline std::to_chars_result result() const noexcept {
+      if (overflow_) {
+        return {last_, std::errc::value_too_large};
+      }
+
+      return {current_, std::errc{}};
+    }
+
+  private:
+    char* current_;
+    char* last_;
+    bool overflow_{false};
+  };
+
+  class fingerprint_sink final : public tag_sink {
+  public:
+    void write(char const* data, std::size_t size) override {
+      for (std::size_t i = 0; i < size; ++i) {
+        state_ ^= static_cast<std::uint8_t>(data[i]);
+        state_ *= 0x100000001b3ULL;
+      }
+    }
+
+    inline std::uint64_t result(std::uint64_t size) const noexcept {
+      auto value = state_ ^ size;
+      value = (value ^ (value >> 33U)) * 0xff51afd7ed558ccdULL;
+      value = (value ^ (value >> 33U)) * 0xc4ceb9fe1a85ec53ULL;
+      return value ^ (value >> 33U);
+    }
+
+  private:
+    std::uint64_t state_{0xcbf29ce484222325ULL};
+  };
+
+  template<typename Sink>
+  inline void encode_tag_level(Sink& sink, dtag_value const& value) {
+    value.encode(sink);
+  }
+
+  template<typename Sink, std::uint8_t Size, typename... Tys>
+  void encode_tag(Sink& sink,
+                  stag<Size, Tys...> const& tag,
+                  std::uint8_t size) {
+    [&]<std::size_t... Idxs>(std::index_sequence<Idxs...> /*unused*/) {
+      static_cast<void>(
+          ((Idxs < size &&
+            (encode_tag_level(sink, std::get<Idxs>(tag.values())), true)) &&
+           ...));
+    }
+    (std::make_index_sequence<Size>{});
+  }
+
+  template<typename Sink, typename Alloc>
+  void encode_tag(Sink& sink, dtag<Alloc> const& tag, std::uint32_t size) {
+    auto& values = tag.values();
+    for (std::uint32_t i = 0; i < size; ++i) {
+      encode_tag_level(sink, values[i]);
+    }
+  }
+
+  template<encodable_tag_value Ty>
+  std::from_chars_result
+      decode_tag_level(char const* first, char const* last, Ty& value) {
+    if (first == last ||
+        static_cast<tag_type_code>(*first) != tag_codec<Ty>::type_code) {
+      return {first, std::errc::invalid_argument};
+    }
+
+    return tag_codec<Ty>::decode(first + 1, last, value);
+  }
+
+  template<typename Fn>
+  std::from_chars_result visit_number_type(tag_type_code code, Fn&& fn) {
+    switch (code) {
+    case tag_type_code::int8:
+      return fn(std::type_identity<std::int8_t>{});
+    case tag_type_code::int16:
+      return fn(std::type_identity<std::int16_t>{});
+    case tag_type_code::int32:
+      return fn(std::type_identity<std::int32_t>{});
+    case tag_type_code::int64:
+      return fn(std::type_identity<std::int64_t>{});
+    case tag_type_code::uint8:
+      return fn(std::type_identity<std::uint8_t>{});
+    case tag_type_code::uint16:
+      return fn(std::type_identity<std::uint16_t>{});
+    case tag_type_code::uint32:
+      return fn(std::type_identity<std::uint32_t>{});
+    case tag_type_code::uint64:
+      return fn(std::type_identity<std::uint64_t>{});
+    case tag_type_code::float32:
+      return fn(std::type_identity<float>{});
+    case tag_type_code::float64:
+      return fn(std::type_identity<double>{});
+    default:
+      return {nullptr, std::errc::invalid_argument};
+    }
+  }
+
+  template<typename Fn>
+  std::from_chars_result visit_tag_type(char const* first,
+                                        char const* last,
+                                        Fn&& fn) {
+    auto code = static_cast<tag_type_code>(*first);
+    switch (code) {
+    case tag_type_code::wildcard:
+      return fn(std::type_identity<wildcard_t>{});
+    case tag_type_code::string:
+      return fn(std::type_identity<std::string>{});
+    case tag_type_code::interval:
+      if (last - first < 2) {
+        return {last, std::errc::invalid_argument};
+      }
+
+      return visit_number_type(static_cast<tag_type_code>(first[1]),
+                               [&fn]<typename Ty>(std::type_identity<Ty>) {
+                                 return fn(std::type_identity<interval<Ty>>{});
+                               });
+    default:
+      return visit_number_type(code, fn);
+    }
+  }
+} // namespace detail
+
+template<taglike Tag>
+std::to_chars_result tag_to_bytes(char* first, char* last, Tag const& tag) {
+  detail::buffer_sink sink{first, last};
+
+  detail::encode_varint(sink, tag.size());
+  detail::encode_tag(sink, tag, tag.size());
+
+  return sink.result();
+}
+
+template<std::uint8_t Size, typename... Tys>
+std::from_chars_result tag_from_bytes(char const* first,
+                                      char const* last,
+                                      stag<Size, Tys...>& tag) {
+  using tag_type = stag<Size, Tys...>;
+
+  std::uint64_t size{};
+  auto result = detail::decode_varint(first, last, size);
+  if (result.ec != std::errc{}) {
+    return result;
+  }
+
+  if (size != Size) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  typename tag_type::storage_type values{};
+  [&]<std::size_t... Idxs>(std::index_sequence<Idxs...> /*unused*/) {
+    static_cast<void>(((result = detail::decode_tag_level(
+                             result.ptr, last, std::get<Idxs>(values)),
+                        result.ec == std::errc{}) &&
+                       ...));
+  }
+  (std::make_index_sequence<Size>{});
+
+  if (result.ec == std::errc{}) {
+    tag = tag_type{std::move(values)};
+  }
+
+  return result;
+}
+
+template<typename Alloc, typename HashCmp = default_hash_compare>
+std::from_chars_result tag_from_bytes(char const* first,
+                                      char const* last,
+                                      dtag<Alloc>& tag,
+                                      Alloc const& alloc,
+                                      HashCmp const& hash_cmp = HashCmp{}) {
+  using tag_type = dtag<Alloc>;
+
+  std::uint64_t size{};
+  auto result = detail::decode_varint(first, last, size);
+  if (result.ec != std::errc{}) {
+    return result;
+  }
+
+  if (size == 0 || size > static_cast<std::uint64_t>(last - result.ptr)) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  typename tag_type::storage_type values{alloc};
+  values.reserve(static_cast<std::size_t>(size));
+
+  for (; size != 0; --size) {
+    if (result.ptr == last) {
+      return {last, std::errc::invalid_argument};
+    }
+
+    auto level = result.ptr;
+    result = detail::visit_tag_type(
+        level, last, [&]<typename Ty>(std::type_identity<Ty> /*unused*/) {
+          Ty value{};
+
+          auto decoded = detail::decode_tag_level(level, last, value);
+          if (decoded.ec == std::errc{}) {
+            values.push_back(
+                make_dtag_node<Ty>(alloc, hash_cmp, std::move(value)));
+          }
+
+          return decoded;
+        });
+
+    if (result.ec != std::errc{}) {
+      if (result.ptr == nullptr) {
+        result.ptr = level;
+      }
+
+      return result;
+    }
+  }
+
+  tag = tag_type{alloc, values.begin(), values.end()};
+  return result;
+}
+
+template<typename Alloc, typename HashCmp = default_hash_compare>
+std::from_chars_result tag_from_bytes(char const* first,
+                                      char const* last,
+                                      dtag<Alloc>& tag,
+                                      HashCmp const& hash_cmp = HashCmp{}) {
+  return tag_from_bytes(first, last, tag, Alloc{}, hash_cmp);
+}
+
+template<taglike Tag>
+std::uint64_t tag_fingerprint(Tag const& tag,
+                              typename Tag::size_type size) {
+  assert(size <= tag.size());
+
+  detail::fingerprint_sink sink{};
+  detail::encode_tag(sink, tag, size);
+
+  return sink.result(size);
+}
+
+template<taglike Tag>
+std::uint64_t tag_fingerprint(Tag const& tag) {
+  return tag_fingerprint(tag, tag.size());
+}
+
+} // namespace frq
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "tag.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace frq {
+
+namespace detail {
+  inline std::to_chars_result begin_tag_level(char* first,
+                                              char* last) noexcept {
+    if (first == last) {
+      return {last, std::errc::value_too_large};
+    }
+
+    *first = '/';
+    return {first + 1, std::errc{}};
+  }
+
+  inline std::to_chars_result end_tag_level(char* level,
+                                            std::to_chars_result result,
+                                            bool wildcard) noexcept {
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    // '/' would split the level and a lone '*' would parse as a wildcard
+    auto text =
+        std::string_view{level, static_cast<std::size_t>(result.ptr - level)};
+    if (text.find('/') != std::string_view::npos ||
+        (!wildcard && text == "*")) {
+      return {level, std::errc::invalid_argument};
+    }
+
+    return result;
+  }
+
+  template<formattable_tag_value Ty>
+  std::to_chars_result
+      format_tag_level(char* first, char* last, Ty const& value) {
+    auto result = begin_tag_level(first, last);
+    if (result.ec != std::errc{}) {
+      return result;
+    }
+
+    return end_tag_level(result.ptr,
+                         tag_formatter<Ty>::to_chars(result.ptr, last, value),
+                         std::is_same_v<Ty, wildcard_t>);
+  }
+
+  inline std::from_chars_result
+      find_tag_level(char const* first, char const* last) noexcept {
+    if (first == last || *first != '/') {
+      return {first, std::errc::invalid_argument};
+    }
+
+    return {std::find(first + 1, last, '/'), std::errc{}};
+  }
+
+  template<formattable_tag_value Ty>
+  std::from_chars_result
+      parse_tag_level(char const* first, char const* last, Ty& value) {
+    auto [end, ec] = find_tag_level(first, last);
+    if (ec != std::errc{}) {
+      return {end, ec};
+    }
+
+    auto result = tag_formatter<Ty>::from_chars(first + 1, end, value);
+    if (result.ec == std::errc{} && result.ptr != end) {
+      return {result.ptr, std::errc::invalid_argument};
+    }
+
+    return result;
+  }
+
+  template<typename Tuple, std::size_t... Idxs>
+  std::to_chars_result format_stag(char* first,
+                                   char* last,
+                                   Tuple const& values,
+                                   std::index_sequence<Idxs...> /*unused*/) {
+    std::to_chars_result result{first, std::errc{}};
+    static_cast<void>(
+        (((result = format_tag_level(result.ptr, last, std::get<Idxs>(values)))
+               .ec == std::errc{}) &&
+         ...));
+
+    return result;
+  }
+
+  template<typename Tuple, std::size_t... Idxs>
+  std::from_chars_result parse_stag(char const* first,
+                                    char const* last,
+                                    Tuple& values,
+                                    std::index_sequence<Idxs...> /*unused*/) {
+    std::from_chars_result result{first, std::errc{}};
+    static_cast<void>(
+        (((result = parse_tag_level(result.ptr, last, std::get<Idxs>(values)))
+               .ec == std::errc{}) &&
+         ...));
+
+    return result;
+  }
+} // namespace detail
+
+template<std::uint8_t Size, typename... Tys>
+std::to_chars_result
+    tag_to_chars(char* first, char* last, stag<Size, Tys...> const& tag) {
+  return detail::format_stag(
+      first, last, tag.values(), std::make_index_sequence<Size>{});
+}
+
+template<typename Alloc>
+std::to_chars_result
+    tag_to_chars(char* first, char* last, dtag<Alloc> const& tag) {
+  std::to_chars_result result{first, std::errc{}};
+  for (auto& value : tag.values()) {
+    result = detail::begin_tag_level(result.ptr, last);
+    if (result.ec == std::errc{}) {
+      result = detail::end_tag_level(
+          result.ptr, value.to_chars(result.ptr, last), value.wildcard());
+    }
+
+    if (result.ec != std::errc{}) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+template<std::uint8_t Size, typename... Tys>
+std::from_chars_result tag_from_chars(char const* first,
+                                      char const* last,
+                                      stag<Size, Tys...>& tag) {
+  using tag_type = stag<Size, Tys...>;
+
+  typename tag_type::storage_type values{};
+
+  auto result = detail::parse_stag(
+      first, last, values, std::make_index_sequence<Size>{});
+  if (result.ec == std::errc{}) {
+    if (result.ptr != last) {
+      return {result.ptr, std::errc::invalid_argument};
+    }
+
+    tag = tag_type{std::move(values)};
+  }
+
+  return result;
+}
+
+template<typename... Tys>
+class dtag_schema {
+public:
+  using size_type = std::uint32_t;
+
+  static constexpr size_type size_v = sizeof...(Tys);
+
+  static_assert((formattable_tag_value<Tys> && ...));
+
+public:
+  template<typename Alloc, typename HashCmp = default_hash_compare>
+  std::from_chars_result parse(char const* first,
+                               char const* last,
+                               dtag<Alloc>& tag,
+                               HashCmp const& hash_cmp = HashCmp{}) const {
+    return parse(first, last, tag, Alloc{}, hash_cmp);
+  }
+
+  template<typename Alloc, typename HashCmp = default_hash_compare>
+  std::from_chars_result parse(char const* first,
+                               char const* last,
+                               dtag<Alloc>& tag,
+                               Alloc const& alloc,
+                               HashCmp const& hash_cmp = HashCmp{}) const {
+    using tag_type = dtag<Alloc>;
+
+    typename tag_type::storage_type values{alloc};
+    values.reserve(size_v);
+
+    std::from_chars_result result{first, std::errc{}};
+    parse_levels(result,
+                 last,
+                 values,
+                 alloc,
+                 hash_cmp,
+                 std::index_sequence_for<Tys...>{});
+
+    if (result.ec == std::errc{}) {
+      if (values.empty() || result.ptr != last) {
+        return {result.ptr, std::errc::invalid_argument};
+      }
+
+      tag = tag_type{alloc, values.begin(), values.end()};
+    }
+
+    return result;
+  }
+
+private:
+  template<typename Storage,
+           typename Alloc,
+           typename HashCmp,
+           std::size_t... Idxs>
+  static void parse_levels(std::from_chars_result& result,
+                           char const* last,
+                           Storage& values,
+                           Alloc const& alloc,
+                           HashCmp const& hash_cmp,
+                           std::index_sequence<Idxs...> /*unused*/) {
+    static_cast<void>(
+        ((result.ptr != last &&
+          (result =
+               parse_level<Tys>(result.ptr, last, values, alloc, hash_cmp))
+                  .ec == std::errc{}) &&
+         ...));
+  }
+
+  template<typename Ty, typename Storage, typename Alloc, typename HashCmp>
+  static std::from_chars_result parse_level(char const* first,
+                                            char const* last,
+                                            Storage& values,
+                                            Alloc const& alloc,
+                                            HashCmp const& hash_cmp) {
+    auto [end, ec] = detail::find_tag_level(first, last);
+    if (ec != std::errc{}) {
+      return {end, ec};
+    }
+
+    auto text = std::string_view{
+        first + 1, static_cast<std::size_t>(end - first - 1)};
+
+    if (text == "*") {
+      values.push_back(make_dtag_node<wildcard_t>(alloc, hash_cmp));
+      return {end, std::errc{}};
+    }
+
+    Ty value{};
+    auto result = detail::parse_tag_level(first, last, value);
+    if (result.ec == std::errc{}) {
+      values.push_back(
+          make_dtag_node<Ty>(alloc, hash_cmp, std::move(value)));
+    }
+
+    return result;
+  }
+};
+
+} // namespace frq
@@ -2,7 +2,9 @@
 
 #include "tag.hpp"
 
+#include <array>
 #include <ostream>
+#include <system_error>
 #include <tuple>
 #include <vector>
 
@@ -28,12 +30,27 @@ namespace detail {
   void tag_stream_helper(std::ostream& stream,
                          std::vector<frq::dtag_value, Alloc> const& values) {
     for (auto& value : values) {
-      stream << '/' << value.get_string();
+      std::array<char, 64> buffer;
+
+      stream << '/';
+      if (auto [ptr, ec] =
+              value.to_chars(buffer.data(), buffer.data() + buffer.size());
+          ec == std::errc{}) {
+        stream.write(buffer.data(), ptr - buffer.data());
+      }
+      else {
+        stream << value.get_string();
+      }
     }
   }
 
 } // namespace detail
 
+template<typename Ty>
+auto& operator<<(std::ostream& stream, interval<Ty> const& range) {
+  return stream << '[' << range.lower() << ',' << range.upper() << ')';
+}
+
 template<taglike Tag>
 auto& operator<<(std::ostream& stream, Tag const& tag) {
   detail::tag_stream_helper(stream, tag.values());
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "executor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace frq {
+
+class timer_wheel;
+
+class timer_entry {
+public:
+  // callbacks run on the thread that advances the wheel and must not block;
+  // work that may block or resume consumers goes to the wheel's executor
+  using callback_type = void (*)(void*) noexcept;
+
+public:
+  inline timer_entry(callback_type callback, void* context) noexcept
+      : callback_{callback}
+      , context_{context} {
+  }
+
+  timer_entry(timer_entry const&) = delete;
+  timer_entry(timer_entry&&) = delete;
+
+  timer_entry& operator=(timer_entry const&) = delete;
+  timer_entry& operator=(timer_entry&&) = delete;
+
+  ~timer_entry() = default;
+
+private:
+  friend timer_wheel;
+
+  callback_type callback_;
+  void* context_;
+
+  timer_entry** head_{nullptr};
+  timer_entry* prev_{nullptr};
+  timer_entry* next_{nullptr};
+
+  std::uint64_t expiry_{0};
+  std::uint64_t id_{0};
+};
+
+class timer_wheel {
+public:
+  using clock_type = std::chrono::steady_clock;
+  using time_point = clock_type::time_point;
+  using duration = clock_type::duration;
+
+  static constexpr std::size_t level_bits = 6;
+  static constexpr std::size_t level_count = 4;
+  static constexpr std::size_t slot_count = std::size_t{1} << level_bits;
+
+private:
+  static constexpr std::uint64_t slot_mask = slot_count - 1;
+  static constexpr std::uint64_t span = std::uint64_t{1}
+                                        << (level_bits * level_count);
+
+  using level_type = std::array<timer_entry*, slot_count>;
+
+public:
+  explicit inline timer_wheel(
+      duration resolution = std::chrono::milliseconds{1},
+      time_point start = clock_type::now(),
+      executor_ref exec = {}) noexcept
+      : start_{start}
+      , resolution_{resolution}
+      , executor_{exec} {
+    assert(resolution.count() > 0);
+  }
+
+  timer_wheel(timer_wheel const&) = delete;
+  timer_wheel(timer_wheel&&) = delete;
+
+  timer_wheel& operator=(timer_wheel const&) = delete;
+  timer_wheel& operator=(timer_wheel&&) = delete;
+
+  ~timer_wheel() = default;
+
+  void schedule(timer_entry& entry, time_point deadline) {
+    std::lock_guard lock{lock_};
+    assert(entry.head_ == nullptr);
+
+    entry.expiry_ = to_tick(deadline);
+    entry.id_ = next_id_++;
+
+    link(entry);
+    if (count_++ == 0) {
+      changed_.notify_all();
+    }
+  }
+
+  bool cancel(timer_entry& entry) {
+    std::unique_lock lock{lock_};
+    if (entry.head_ != nullptr) {
+      unlink(entry);
+      --count_;
+      return true;
+    }
+
+    changed_.wait(lock, [this, id = entry.id_] { return firing_ != id; });
+    return false;
+  }
+
+  std::size_t advance(time_point now) {
+    auto target = elapsed(now);
+
+    std::size_t fired{0};
+    std::unique_lock lock{lock_};
+
+    for (;;) {
+      if (due_ == nullptr) {
+        if (count_ == 0) {
+          current_ = std::max(current_, target);
+          break;
+        }
+
+        if (current_ >= target) {
+          break;
+        }
+
+        tick();
+        continue;
+      }
+
+      auto& entry = *due_;
+      unlink(entry);
+      --count_;
+
+      firing_ = entry.id_;
+      auto callback = entry.callback_;
+      auto context = entry.context_;
+
+      lock.unlock();
+      callback(context);
+      lock.lock();
+
+      firing_ = 0;
+      changed_.notify_all();
+
+      ++fired;
+    }
+
+    return fired;
+  }
+
+  bool wait(std::stop_token const& stop) {
+    std::unique_lock lock{lock_};
+    return changed_.wait(lock, stop, [this] { return count_ != 0; });
+  }
+
+  inline bool empty() const {
+    std::lock_guard lock{lock_};
+    return count_ == 0;
+  }
+
+  inline duration resolution() const noexcept {
+    return resolution_;
+  }
+
+  inline executor_ref executor() const noexcept {
+    return executor_;
+  }
+
+private:
+  inline std::uint64_t to_tick(time_point point) const noexcept {
+    if (point <= start_) {
+      return 0;
+    }
+
+    return static_cast<std::uint64_t>(
+        (point - start_ + resolution_ - duration{1}) / resolution_);
+  }
+
+  inline std::uint64_t elapsed(time_point point) const noexcept {
+    if (point <= start_) {
+      return 0;
+    }
+
+    return static_cast<std::uint64_t>((point - start_) / resolution_);
+  }
+
+  void link(timer_entry& entry) noexcept {
+    if (entry.expiry_ <= current_) {
+      push(due_, entry);
+      return;
+    }
+
+    auto expiry = std::min(entry.expiry_, current_ + span - 1);
+    auto delta = expiry - current_;
+
+    std::size_t level{0};
+    while (level + 1 < level_count &&
+           delta >= (std::uint64_t{1} << (level_bits * (level + 1)))) {
+      ++level;
+    }
+
+    auto slot = (expiry >> (level_bits * level)) & slot_mask;
+    push(levels_[level][slot], entry);
+  }
+
+  static inline void push(timer_entry*& head, timer_entry& entry) noexcept {
+    entry.head_ = &head;
+    entry.prev_ = nullptr;
+    entry.next_ = head;
+
+    if (head != nullptr) {
+      head->prev_ = &entry;
+    }
+
+    head = &entry;
+  }
+
+  static inline void unlink(timer_entry& entry) noexcept {
+    if (entry.prev_ != nullptr) {
+      entry.prev_->next_ = entry.next_;
+    }
+    else {
+      *entry.head_ = entry.next_;
+    }
+
+    if (entry.next_ != nullptr) {
+      entry.next_->prev_ = entry.prev_;
+    }
+
+    entry.head_ = nullptr;
+  }
+
+  void tick() noexcept {
+    ++current_;
+
+    for (auto level = level_count - 1; level != 0; --level) {
+      auto shift = level_bits * level;
+      if ((current_ & ((std::uint64_t{1} << shift) - 1)) == 0) {
+        cascade(levels_[level][(current_ >> shift) & slot_mask]);
+      }
+    }
+
+    cascade(levels_[0][current_ & slot_mask]);
+  }
+
+  void cascade(timer_entry*& head) noexcept {
+    auto entry = std::exchange(head, nullptr);
+    while (entry != nullptr) {
+      auto next = entry->next_;
+      link(*entry);
+      entry = next;
+    }
+  }
+
+private:
+  mutable std::mutex lock_;
+  std::condition_variable_any changed_;
+
+  time_point start_;
+  duration resolution_;
+  executor_ref executor_;
+
+  std::array<level_type, level_count> levels_{};
+  timer_entry* due_{nullptr};
+
+  std::uint64_t current_{0};
+  std::size_t count_{0};
+
+  std::uint64_t next_id_{1};
+  std::uint64_t firing_{0};
+};
+
+class timer_service {
+public:
+  explicit inline timer_service(
+      timer_wheel::duration resolution = std::chrono::milliseconds{1})
+      : wheel_{resolution, timer_wheel::clock_type::now(), dispatch_}
+      , thread_{[this](std::stop_token stop) { run(stop); }} {
+  }
+
+  timer_service(timer_service const&) = delete;
+  timer_service(timer_service&&) = delete;
+
+  timer_service& operator=(timer_service const&) = delete;
+  timer_service& operator=(timer_service&&) = delete;
+
+  ~timer_service() = default;
+
+  inline timer_wheel& wheel() noexcept {
+    return wheel_;
+  }
+
+private:
+  void run(std::stop_token const& stop) {
+    while (wheel_.wait(stop)) {
+      std::this_thread::sleep_for(wheel_.resolution());
+      wheel_.advance(timer_wheel::clock_type::now());
+    }
+  }
+
+private:
+  thread_executor dispatch_;
+  timer_wheel wheel_;
+  std::jthread thread_;
+};
+
+inline timer_wheel& default_timer_wheel() {
+  static timer_service service{};
+  return service.wheel();
+}
+
+} // namespace frq
@@ -1,9 +1,19 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <utility>
 
 namespace frq {
 namespace detail {
+  inline constexpr std::size_t cache_line_size = 64;
+
+  inline void cpu_relax() noexcept {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#endif
+  }
+
   template<typename Alloc, typename Ty>
   struct rebind_alloc {
     using type =
@@ -22,5 +32,78 @@ namespace detail {
       std::is_nothrow_move_assignable_v<std::decay_t<Ty>>) {
     std::decay_t<Ty>{std::move(obj)};
   }
+
+  template<typename Ty, typename Alloc>
+  class alloc_ptr {
+  public:
+    using element_type = Ty;
+    using allocator_type = rebind_alloc_t<Alloc, element_type>;
+
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+  public:
+    template<typename... Tys>
+    inline alloc_ptr(std::allocator_arg_t /*unused*/,
+                     Alloc const& alloc,
+                     Tys&&... args)
+        : alloc_{alloc}
+        , ptr_{alloc_traits::allocate(alloc_, 1)} {
+      try {
+        alloc_traits::construct(alloc_, ptr_, std::forward<Tys>(args)...);
+      }
+      catch (...) {
+        alloc_traits::deallocate(alloc_, ptr_, 1);
+        throw;
+      }
+    }
+
+    inline alloc_ptr(alloc_ptr&& other) noexcept
+        : alloc_{other.alloc_}
+        , ptr_{std::exchange(other.ptr_, nullptr)} {
+    }
+
+    inline ~alloc_ptr() {
+      reset();
+    }
+
+    alloc_ptr(alloc_ptr const&) = delete;
+    alloc_ptr& operator=(alloc_ptr const&) = delete;
+
+    inline alloc_ptr& operator=(alloc_ptr&& rhs) noexcept {
+      if (this != &rhs) {
+        reset();
+
+        alloc_ = rhs.alloc_;
+        ptr_ = std::exchange(rhs.ptr_, nullptr);
+      }
+
+      return *this;
+    }
+
+    inline element_type* get() const noexcept {
+      return ptr_;
+    }
+
+    inline element_type& operator*() const noexcept {
+      return *ptr_;
+    }
+
+    inline element_type* operator->() const noexcept {
+      return ptr_;
+    }
+
+  private:
+    inline void reset() noexcept {
+      if (ptr_ != nullptr) {
+        alloc_traits::destroy(alloc_, ptr_);
+        alloc_traits::deallocate(alloc_, std::exchange(ptr_, nullptr), 1);
+      }
+    }
+
+  private:
+    [[no_unique_address]] allocator_type alloc_;
+    element_type* ptr_;
+  };
 } // namespace detail
 } // namespace frq
@@ -1,13 +1,15 @@
 
 #include "mutex.hpp"
 
+#include <utility>
+
 bool frq::detail::mximpl::lock(mxwait& entry) noexcept {
   auto expected{free_state};
   auto desired{taken_state};
 
   while (!state_.compare_exchange_weak(expected,
                                        desired,
-                                       std::memory_order_acquire,
+                                       std::memory_order_acq_rel,
                                        std::memory_order_relaxed)) {
     if (!expected.is_free()) {
       entry.next_ = expected.get_waiter();
@@ -38,30 +40,120 @@ bool frq::detail::mximpl::try_lock() noexcept {
 void frq::detail::mximpl::release() {
   assert(!state_.load(std::memory_order_relaxed).is_free());
 
-  auto* head = waiters_;
-  if (head == nullptr) {
-    auto expected{taken_state};
+  while (true) {
+    auto* head = waiters_;
+    if (head == nullptr) {
+      auto expected{taken_state};
 
-    if (state_.compare_exchange_strong(expected,
-                                       free_state,
-                                       std::memory_order_release,
-                                       std::memory_order_relaxed)) {
+      if (state_.compare_exchange_strong(expected,
+                                         free_state,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+        return;
+      }
+
+      expected = state_.exchange(taken_state, std::memory_order_acquire);
+
+      auto* cur = expected.get_waiter();
+      do {
+        auto* next = cur->next_;
+        cur->next_ = head;
+        head = cur;
+        cur = next;
+      } while (cur != nullptr);
+    }
+
+    waiters_ = head->next_;
+
+    if (head->grant_ == nullptr) {
+      head->waiter_.resume();
+      return;
+    }
+
+    if (head->grant_(*head)) {
       return;
     }
+  }
+}
+
+frq::detail::mxtimed::mxtimed(std::coroutine_handle<> waiter,
+                              timer_wheel& timers) noexcept
+    : mxwait{.waiter_ = waiter, .grant_ = &grant}
+    , timers_{&timers}
+    , entry_{&expire, this} {
+}
+
+bool frq::detail::mxtimed::arrive() noexcept {
+  return arrivals_.fetch_add(1, std::memory_order_acq_rel) == 1;
+}
+
+void frq::detail::mxtimed::drop() noexcept {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
 
-    expected = state_.exchange(taken_state, std::memory_order_acquire);
+bool frq::detail::mxtimed::grant(mxwait& entry) noexcept {
+  auto& self = static_cast<mxtimed&>(entry);
+
+  auto expected{waiting_status};
+  auto granted = self.status_.compare_exchange_strong(
+      expected, granted_status, std::memory_order_acq_rel);
+
+  self.drop();
+
+  if (granted && self.arrive()) {
+    self.waiter_.resume();
+  }
+
+  return granted;
+}
+
+void frq::detail::mxtimed::expire(void* context) noexcept {
+  auto& self = *static_cast<mxtimed*>(context);
+
+  auto expected{waiting_status};
+  if (self.status_.compare_exchange_strong(
+          expected, expired_status, std::memory_order_acq_rel) &&
+      self.arrive()) {
+    self.timers_->executor().post(self.waiter_);
+  }
+}
+
+bool frq::mutex::timed_awaitable::await_ready() noexcept {
+  acquired_ = impl_->try_lock();
+  return acquired_ || timer_wheel::clock_type::now() >= deadline_;
+}
+
+bool frq::mutex::timed_awaitable::await_suspend(
+    std::coroutine_handle<> handle) {
+  auto* node = new detail::mxtimed{handle, *timers_};
+  node_ = node;
+
+  if (impl_->lock(*node)) {
+    acquired_ = true;
+    node_ = nullptr;
+
+    delete node;
+    return false;
+  }
+
+  timers_->schedule(node->entry(), deadline_);
+  return !node->arrive();
+}
+
+bool frq::mutex::timed_awaitable::await_resume() noexcept {
+  if (node_ == nullptr) {
+    return acquired_;
+  }
 
-    auto* cur = expected.get_waiter();
-    do {
-      auto* next = cur->next_;
-      cur->next_ = head;
-      head = cur;
-      cur = next;
-    } while (cur != nullptr);
+  auto granted = node_->granted();
+  if (granted) {
+    timers_->cancel(node_->entry());
   }
 
-  waiters_ = head->next_;
-  head->waiter_.resume();
+  std::exchange(node_, nullptr)->drop();
+  return granted;
 }
 
 frq::mutex_guard frq::mutex::scoped_awaitable::await_resume() noexcept {
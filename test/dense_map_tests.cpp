@@ -0,0 +1,138 @@
+
+#include "dense_map.hpp"
+
+#include "counted.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+enum class level : std::uint8_t { first, second, third, count };
+enum class signed_level : int { first, second, count };
+} // namespace
+
+template<>
+struct frq::tag_domain<level>
+    : frq::bounded_tag_domain<level, static_cast<std::size_t>(level::count)> {
+};
+
+template<>
+struct frq::tag_domain<signed_level>
+    : frq::bounded_tag_domain<signed_level,
+                              static_cast<std::size_t>(signed_level::count)> {
+};
+
+static_assert(frq::bounded_tag_key<level>);
+static_assert(!frq::bounded_tag_key<int>);
+
+using map_type = frq::detail::dense_map<level, int>;
+
+class dense_map_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  auto insert(level key, int value) {
+    return map_.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple(value));
+  }
+
+  map_type map_{};
+};
+
+TEST_F(dense_map_tests, is_empty_when_empty) {
+  EXPECT_TRUE(map_.empty());
+  EXPECT_EQ(map_.end(), map_.begin());
+}
+
+TEST_F(dense_map_tests, find_in_empty) {
+  EXPECT_EQ(map_.end(), map_.find(level::second));
+}
+
+TEST_F(dense_map_tests, emplace_to_empty) {
+  auto [pos, inserted] = insert(level::second, 2);
+
+  EXPECT_TRUE(inserted);
+  EXPECT_FALSE(map_.empty());
+  EXPECT_EQ(level::second, pos->first);
+  EXPECT_EQ(2, pos->second);
+}
+
+TEST_F(dense_map_tests, emplace_existing) {
+  std::ignore = insert(level::second, 2);
+  auto [pos, inserted] = insert(level::second, 3);
+
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(2, pos->second);
+  EXPECT_EQ(1, map_.size());
+}
+
+TEST_F(dense_map_tests, find_existing) {
+  std::ignore = insert(level::third, 3);
+
+  auto pos = map_.find(level::third);
+
+  ASSERT_NE(map_.end(), pos);
+  EXPECT_EQ(3, pos->second);
+}
+
+TEST_F(dense_map_tests, iterate_skips_empty_slots) {
+  std::ignore = insert(level::third, 3);
+  std::ignore = insert(level::first, 1);
+
+  int sum{0};
+  for (auto& [key, value] : map_) {
+    sum += value;
+  }
+
+  EXPECT_EQ(4, sum);
+}
+
+TEST_F(dense_map_tests, erase_last) {
+  auto [pos, inserted] = insert(level::first, 1);
+
+  map_.erase(pos);
+
+  EXPECT_TRUE(map_.empty());
+  EXPECT_EQ(map_.end(), map_.find(level::first));
+}
+
+TEST_F(dense_map_tests, out_of_range_key) {
+  auto const key = static_cast<level>(7);
+
+  EXPECT_EQ(map_.end(), map_.find(key));
+  EXPECT_THROW(std::ignore = insert(key, 7), std::out_of_range);
+  EXPECT_TRUE(map_.empty());
+}
+
+TEST(dense_map_range_tests, negative_key) {
+  frq::detail::dense_map<signed_level, int> map{};
+  auto const key = static_cast<signed_level>(-1);
+
+  EXPECT_EQ(map.end(), map.find(key));
+  EXPECT_THROW(std::ignore = map.emplace(std::piecewise_construct,
+                                         std::forward_as_tuple(key),
+                                         std::forward_as_tuple(1)),
+               std::out_of_range);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(dense_map_lifetime_tests, destroys_values) {
+  counted_guard guard{};
+  {
+    frq::detail::dense_map<level, counted> map{};
+    std::ignore = map.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(level::first),
+                              std::forward_as_tuple());
+    std::ignore = map.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(level::third),
+                              std::forward_as_tuple());
+
+    EXPECT_EQ(2, counted::get_instances());
+  }
+  EXPECT_EQ(0, counted::get_instances());
+}
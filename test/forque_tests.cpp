@@ -4,7 +4,14 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <vector>
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
 
@@ -21,6 +28,32 @@ using runque_type = frq::make_runque_t<frq::fifo_order,
 using static_tag = frq::stag_t<int, float>;
 using static_queue = frq::forque<item_type, runque_type, static_tag>;
 
+struct dense_key {
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  constexpr inline dense_key(int value) noexcept
+      : value_{static_cast<std::uint8_t>(value)} {
+  }
+
+  std::uint8_t value_;
+};
+
+template<>
+struct frq::tag_domain<dense_key> {
+  static constexpr bool is_bounded = true;
+  static constexpr std::size_t size_v = 16;
+
+  static constexpr inline std::size_t index(dense_key const& key) noexcept {
+    return key.value_;
+  }
+};
+
+using dense_tag = frq::stag_t<dense_key, float>;
+using dense_queue = frq::forque<item_type, runque_type, dense_tag>;
+
+using range_type = frq::interval<int>;
+using range_tag = frq::stag_t<int, range_type>;
+using range_queue = frq::forque<item_type, runque_type, range_tag>;
+
 using dynamic_tag = frq::dtag<>;
 using dynamic_queue = frq::forque<item_type, runque_type, dynamic_tag>;
 
@@ -142,6 +175,9 @@ using static_queue_test =
 using dynamic_queue_test =
     queue_test_impl<dynamic_queue, dynamic_tag, dsub_tag_t>;
 
+using dense_queue_test =
+    queue_test_impl<dense_queue, dense_tag, frq::sub_tag_t>;
+
 class static_queue_tests : public testing::Test {
 protected:
   void SetUp() override {
@@ -158,6 +194,14 @@ protected:
   dynamic_queue_test impl_;
 };
 
+class dense_queue_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  dense_queue_test impl_;
+};
+
 template<typename Test>
 void serving_leaf_impl(Test& test) {
   test.push_sync(1.0F, 1, 1.0F);
@@ -174,6 +218,10 @@ TEST_F(dynamic_queue_tests, serving_leaf) {
   serving_leaf_impl(impl_);
 }
 
+TEST_F(dense_queue_tests, serving_leaf) {
+  serving_leaf_impl(impl_);
+}
+
 template<typename Test>
 void serving_root_impl(Test& test) {
   test.push_sync(1.0F, 1);
@@ -190,6 +238,10 @@ TEST_F(dynamic_queue_tests, serving_root) {
   serving_root_impl(impl_);
 }
 
+TEST_F(dense_queue_tests, serving_root) {
+  serving_root_impl(impl_);
+}
+
 template<typename Test>
 void serving_after_release_impl(Test& test) {
   test.push_sync(
@@ -224,6 +276,10 @@ TEST_F(dynamic_queue_tests, serving_after_release) {
   serving_after_release_impl(impl_);
 }
 
+TEST_F(dense_queue_tests, serving_after_release) {
+  serving_after_release_impl(impl_);
+}
+
 template<typename Test>
 void serving_after_finalize_impl(Test& test) {
   test.push_sync(2.0F, 1, 2.0F);
@@ -255,4 +311,699 @@ TEST_F(dynamic_queue_tests, serving_after_finalize) {
   serving_after_finalize_impl(impl_);
 }
 
+TEST_F(dense_queue_tests, serving_after_finalize) {
+  serving_after_finalize_impl(impl_);
+}
+
+class dynamic_path_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  template<typename... Args>
+  void push(item_type value, Args&&... args) {
+    frq::sync_wait(queue_.reserve(
+        dynamic_tag{frq::construct_tag_default, std::forward<Args>(args)...},
+        value));
+  }
+
+  retainment_type pop() {
+    return frq::sync_wait(queue_.get());
+  }
+
+  static void finalize(retainment_type& item) {
+    frq::sync_wait(item.finalize());
+  }
+
+  dynamic_queue queue_;
+};
+
+TEST_F(dynamic_path_tests, first_level_keys_are_distinct) {
+  push(1.0F, 1, 2.0F);
+  push(2.0F, 5, 2.0F);
+
+  auto item1 = pop();
+  auto item2 = pop();
+
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item1);
+  finalize(item2);
+}
+
+TEST_F(dynamic_path_tests, diverging_path_is_not_blocked) {
+  push(1.0F, 1, 2, 3, 4);
+  push(2.0F, 1, 2, 5);
+
+  auto item1 = pop();
+  auto item2 = pop();
+
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item2);
+  finalize(item1);
+}
+
+TEST_F(dynamic_path_tests, prefix_waits_for_deeper_path) {
+  push(1.0F, 1, 2, 3, 4);
+  push(2.0F, 1, 2);
+  push(3.0F, 1, 2, 6);
+
+  auto item1 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  finalize(item1);
+
+  auto item2 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+  finalize(item2);
+
+  auto item3 = pop();
+  EXPECT_EQ(3.0F, item3.value());
+  finalize(item3);
+}
+
+TEST_F(dynamic_path_tests, deeper_path_waits_for_prefix) {
+  push(1.0F, 1, 2);
+  push(2.0F, 1, 2, 3, 4);
+  push(3.0F, 1, 2, 3, 5);
+
+  auto item1 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  finalize(item1);
+
+  auto item2 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(5.0F, item2.value() + item3.value());
+
+  finalize(item3);
+  finalize(item2);
+}
+
+TEST_F(dynamic_path_tests, path_reused_after_cleanup) {
+  push(1.0F, 1, 2, 3);
+
+  auto item1 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  finalize(item1);
+
+  push(2.0F, 1, 2, 4);
+  push(3.0F, 1, 2, 3);
+
+  auto item2 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item2);
+  finalize(item3);
+}
+
+TEST_F(dynamic_path_tests, wildcard_waits_for_matching_branches) {
+  push(1.0F, 1, 2, 3);
+  push(2.0F, 1, 4, 5);
+  push(3.0F, 1, frq::wildcard, 3);
+
+  auto item1 = pop();
+  auto item2 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item1);
+
+  auto item3 = pop();
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item3);
+  finalize(item2);
+}
+
+TEST_F(dynamic_path_tests, matching_branches_wait_for_wildcard) {
+  push(1.0F, 1, frq::wildcard, 3);
+  push(2.0F, 1, 2, 3);
+  push(3.0F, 1, 2, 4);
+
+  auto item1 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item1);
+
+  auto item2 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item2);
+  finalize(item3);
+}
+
+TEST_F(dynamic_path_tests, wildcards_are_ordered) {
+  push(1.0F, 1, frq::wildcard, 3);
+  push(2.0F, 1, frq::wildcard, 3);
+  push(3.0F, 1, frq::wildcard, 4);
+
+  auto item1 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item1);
+
+  auto item2 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item2);
+  finalize(item3);
+}
+
+TEST_F(dynamic_path_tests, prefix_waits_for_wildcard) {
+  push(1.0F, 1, frq::wildcard, 3);
+  push(2.0F, 1);
+
+  auto item1 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  finalize(item1);
+
+  auto item2 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+  finalize(item2);
+}
+
+TEST_F(dynamic_path_tests, wildcard_splits_compressed_path) {
+  push(1.0F, 1, 2, 3, 4);
+  push(2.0F, 1, frq::wildcard, 3, 4);
+  push(3.0F, 1, frq::wildcard, 3, 5);
+
+  auto item1 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item1);
+
+  auto item2 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item3);
+  finalize(item2);
+}
+
+class range_path_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  void push(item_type value, int key) {
+    frq::sync_wait(queue_.reserve(
+        frq::sub_tag_t<range_tag, 1>{frq::construct_tag_default, key},
+        value));
+  }
+
+  void push(item_type value, int key, range_type range) {
+    frq::sync_wait(queue_.reserve(
+        range_tag{frq::construct_tag_default, key, range}, value));
+  }
+
+  retainment_type pop() {
+    return frq::sync_wait(queue_.get());
+  }
+
+  static void finalize(retainment_type& item) {
+    frq::sync_wait(item.finalize());
+  }
+
+  range_queue queue_;
+};
+
+TEST_F(range_path_tests, disjoint_ranges_are_not_blocked) {
+  push(1.0F, 1, range_type{0, 10});
+  push(2.0F, 1, range_type{10, 20});
+
+  auto item1 = pop();
+  auto item2 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item2);
+  finalize(item1);
+}
+
+TEST_F(range_path_tests, overlapping_ranges_are_serialized) {
+  push(1.0F, 1, range_type{0, 10});
+  push(2.0F, 1, range_type{5, 15});
+  push(3.0F, 1, range_type{20, 30});
+  push(4.0F, 1, range_type{0, 30});
+
+  auto item1 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item1);
+
+  auto item2 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+
+  finalize(item3);
+  finalize(item2);
+
+  auto item4 = pop();
+  EXPECT_EQ(4.0F, item4.value());
+  finalize(item4);
+}
+
+TEST_F(range_path_tests, ranges_wait_for_prefix) {
+  push(1.0F, 1);
+  push(2.0F, 1, range_type{0, 10});
+  push(3.0F, 1, range_type{10, 20});
+  push(4.0F, 1);
+
+  auto item1 = pop();
+  EXPECT_EQ(1.0F, item1.value());
+  finalize(item1);
+
+  auto item2 = pop();
+  auto item3 = pop();
+  EXPECT_EQ(2.0F, item2.value());
+  EXPECT_EQ(3.0F, item3.value());
+
+  finalize(item2);
+  finalize(item3);
+
+  auto item4 = pop();
+  EXPECT_EQ(4.0F, item4.value());
+  finalize(item4);
+}
+
+TEST(edf_forque_tests, serves_earliest_deadline) {
+  using clock_type = std::chrono::steady_clock;
+
+  struct job {
+    int id_;
+    clock_type::time_point deadline_;
+
+    inline clock_type::time_point deadline() const noexcept {
+      return deadline_;
+    }
+  };
+
+  using job_retainment = frq::retainment<job>;
+  using job_runque = frq::make_runque_t<frq::edf_order,
+                                        frq::coro_thread_model,
+                                        job_retainment,
+                                        std::allocator<job_retainment>>;
+
+  frq::forque<job, job_runque, static_tag> queue{};
+
+  auto now = clock_type::now();
+
+  auto reserved = frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}));
+
+  frq::sync_wait(queue.reserve(static_tag{frq::construct_tag_default, 2, 1.0F},
+                               job{2, now + std::chrono::hours{2}}));
+  frq::sync_wait(queue.reserve(static_tag{frq::construct_tag_default, 3, 1.0F},
+                               job{3, now - std::chrono::hours{1}}));
+
+  frq::sync_wait(reserved.release(job{1, now + std::chrono::hours{1}}));
+
+  std::vector<job_retainment> items{};
+  for (int i = 0; i < 3; ++i) {
+    items.push_back(frq::sync_wait(queue.get()));
+  }
+
+  EXPECT_EQ(3, items[0].value().id_);
+  EXPECT_EQ(1, items[1].value().id_);
+  EXPECT_EQ(2, items[2].value().id_);
+
+  using queue_type = std::decay_t<decltype(queue.get_runque().get_queue())>;
+  EXPECT_LT(queue_type::slack(items[0]), queue_type::duration::zero());
+  EXPECT_GT(queue_type::slack(items[1]), queue_type::duration::zero());
+
+  EXPECT_EQ(3, queue.get_runque().get_queue().served());
+  EXPECT_EQ(1, queue.get_runque().get_queue().missed());
+
+  for (auto& item : items) {
+    frq::sync_wait(item.finalize());
+  }
+}
+
+namespace {
+using sequenced_runque =
+    frq::make_runque_t<frq::reservation_order,
+                       frq::coro_thread_model,
+                       retainment_type,
+                       std::allocator<retainment_type>>;
+
+template<typename Queue, typename Tag>
+std::vector<float> serve_late_release(Tag const& early,
+                                      Tag const& second,
+                                      Tag const& third) {
+  Queue queue{};
+
+  auto reserved = frq::sync_wait(queue.reserve(early));
+  frq::sync_wait(queue.reserve(second, 2.0F));
+  frq::sync_wait(queue.reserve(third, 3.0F));
+  frq::sync_wait(reserved.release(1.0F));
+
+  std::vector<retainment_type> items{};
+  for (int i = 0; i < 3; ++i) {
+    items.push_back(frq::sync_wait(queue.get()));
+  }
+
+  std::vector<float> result{};
+  for (auto& item : items) {
+    result.push_back(item.value());
+    frq::sync_wait(item.finalize());
+  }
+
+  return result;
+}
+} // namespace
+
+TEST(reservation_order_tests, fifo_serves_by_readiness) {
+  EXPECT_EQ((std::vector<float>{2.0F, 3.0F, 1.0F}),
+            serve_late_release<static_queue>(
+                static_tag{frq::construct_tag_default, 1, 1.0F},
+                static_tag{frq::construct_tag_default, 2, 1.0F},
+                static_tag{frq::construct_tag_default, 3, 1.0F}));
+}
+
+TEST(reservation_order_tests, serves_by_reservation) {
+  using queue_type = frq::forque<item_type, sequenced_runque, static_tag>;
+
+  EXPECT_EQ((std::vector<float>{1.0F, 2.0F, 3.0F}),
+            serve_late_release<queue_type>(
+                static_tag{frq::construct_tag_default, 1, 1.0F},
+                static_tag{frq::construct_tag_default, 2, 1.0F},
+                static_tag{frq::construct_tag_default, 3, 1.0F}));
+}
+
+TEST(reservation_order_tests, serves_ranges_by_reservation) {
+  using queue_type = frq::forque<item_type, sequenced_runque, range_tag>;
+
+  EXPECT_EQ((std::vector<float>{1.0F, 2.0F, 3.0F}),
+            serve_late_release<queue_type>(
+                range_tag{frq::construct_tag_default, 1, range_type{0, 10}},
+                range_tag{frq::construct_tag_default, 2, range_type{0, 10}},
+                range_tag{frq::construct_tag_default, 3, range_type{0, 10}}));
+}
+
+TEST(reservation_order_tests, serves_dynamic_by_reservation) {
+  using queue_type = frq::forque<item_type, sequenced_runque, dynamic_tag>;
+
+  EXPECT_EQ((std::vector<float>{1.0F, 2.0F, 3.0F}),
+            serve_late_release<queue_type>(
+                dynamic_tag{frq::construct_tag_default, 1, 1},
+                dynamic_tag{frq::construct_tag_default, 2, 1},
+                dynamic_tag{frq::construct_tag_default, 3, frq::wildcard, 3}));
+}
+
+TEST(aging_priority_tests, reports_age_of_retainment) {
+  struct item_priority {
+    inline int operator()(item_type value) const noexcept {
+      return static_cast<int>(value);
+    }
+  };
+
+  using aging_runque =
+      frq::make_runque_t<frq::aging_priority_order,
+                         frq::coro_thread_model,
+                         retainment_type,
+                         std::allocator<retainment_type>,
+                         item_priority>;
+
+  frq::forque<item_type, aging_runque, static_tag> queue{};
+
+  frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}, 1.0F));
+  frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 2, 1.0F}, 2.0F));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+  auto first = frq::sync_wait(queue.get());
+  auto second = frq::sync_wait(queue.get());
+
+  EXPECT_EQ(2.0F, first.value());
+  EXPECT_EQ(1.0F, second.value());
+  EXPECT_LE(std::chrono::milliseconds{5}, first.age());
+
+  frq::sync_wait(first.finalize());
+  frq::sync_wait(second.finalize());
+}
+
+TEST(item_layout_tests, plain_queue_skips_policy_fields) {
+  using plain_node = frq::detail::item_node<item_type, false, false, false>;
+  using aging_node = frq::detail::item_node<item_type, false, false, true>;
+
+  EXPECT_EQ(sizeof(frq::detail::item_handle<item_type>), sizeof(plain_node));
+  EXPECT_LT(sizeof(plain_node), sizeof(aging_node));
+
+  using plain_slot = frq::detail::item_slot<item_type, false, false>;
+  using inheriting_slot = frq::detail::item_slot<item_type, true, true>;
+
+  EXPECT_EQ(sizeof(std::optional<item_type>) + sizeof(void*),
+            sizeof(plain_slot));
+  EXPECT_LT(sizeof(plain_slot), sizeof(inheriting_slot));
+}
+
+TEST(executor_forque_tests, posts_woken_consumer) {
+  struct deferred_executor {
+    void post(std::coroutine_handle<> handle) {
+      handles_.push_back(handle);
+    }
+
+    std::vector<std::coroutine_handle<>> handles_;
+  };
+
+  static_queue queue{};
+  deferred_executor executor{};
+
+  float result{0};
+  auto getter = [](static_queue& queue,
+                   deferred_executor& executor,
+                   float& result) -> frq::task<> {
+    auto retainment = co_await queue.get(executor);
+    result = retainment.value();
+
+    co_await retainment.finalize();
+  }(queue, executor, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}, 1.0F));
+
+  EXPECT_EQ(0.0F, result);
+  ASSERT_EQ(1, executor.handles_.size());
+
+  executor.handles_.front().resume();
+  EXPECT_EQ(1.0F, result);
+}
+
+class batch_counting_runque : public runque_type {
+public:
+  using runque_type::runque_type;
+
+  frq::task<> put_many(std::span<retainment_type> values) {
+    batches_.push_back(values.size());
+    co_await runque_type::put_many(values);
+  }
+
+  std::vector<std::size_t> batches_;
+};
+
+TEST(batch_forque_tests, finalize_releases_children_in_one_batch) {
+  using parent_tag = frq::sub_tag_t<static_tag, 1>;
+
+  frq::forque<item_type, batch_counting_runque, static_tag> queue{};
+
+  auto parent = frq::sync_wait(
+      queue.reserve(parent_tag{frq::construct_tag_default, 1}));
+
+  for (int i = 0; i < 10; ++i) {
+    auto value = static_cast<float>(i);
+    frq::sync_wait(queue.reserve(
+        static_tag{frq::construct_tag_default, 1, value}, value));
+  }
+
+  frq::sync_wait(parent.release(100.0F));
+
+  auto root = frq::sync_wait(queue.get());
+  EXPECT_EQ(100.0F, root.value());
+
+  frq::sync_wait(root.finalize());
+  EXPECT_EQ(std::vector<std::size_t>{10}, queue.get_runque().batches_);
+
+  float sum{0};
+  for (int i = 0; i < 10; ++i) {
+    auto child = frq::sync_wait(queue.get());
+    sum += child.value();
+
+    frq::sync_wait(child.finalize());
+  }
+
+  EXPECT_EQ(45.0F, sum);
+}
+
+TEST(try_get_forque_tests, returns_ready_items_only) {
+  static_queue queue{};
+
+  EXPECT_FALSE(queue.try_get().has_value());
+
+  auto reservation = frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}));
+  frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}, 2.0F));
+
+  EXPECT_FALSE(queue.try_get().has_value());
+
+  frq::sync_wait(reservation.release(1.0F));
+
+  auto first = queue.try_get();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(1.0F, first->value());
+  EXPECT_FALSE(queue.try_get().has_value());
+
+  frq::sync_wait(first->finalize());
+
+  auto second = queue.try_get();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(2.0F, second->value());
+
+  frq::sync_wait(second->finalize());
+}
+
+TEST(timed_forque_tests, reserve_until_uncontended) {
+  using namespace std::chrono_literals;
+
+  static_queue queue{};
+  static_tag const tag{frq::construct_tag_default, 1, 1.0F};
+
+  auto deadline = frq::timer_wheel::clock_type::now() + 1s;
+
+  auto reservation = frq::sync_wait(queue.reserve_until(tag, deadline));
+  ASSERT_TRUE(reservation.has_value());
+
+  EXPECT_TRUE(frq::sync_wait(queue.reserve_for(tag, 2.0F, 1s)));
+
+  frq::sync_wait(reservation->release(1.0F));
+
+  auto first = frq::sync_wait(queue.get_for(1s));
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(1.0F, first->value());
+
+  frq::sync_wait(first->finalize());
+
+  auto second = frq::sync_wait(queue.get_until(deadline));
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(2.0F, second->value());
+
+  frq::sync_wait(second->finalize());
+}
+
+TEST(timed_forque_tests, get_until_expires) {
+  using namespace std::chrono_literals;
+
+  auto start = frq::timer_wheel::clock_type::now() + 1h;
+  frq::timer_wheel timers{1ms, start};
+
+  static_queue queue{};
+
+  std::optional<retainment_type> result{};
+  bool done{false};
+
+  auto getter = [](static_queue& queue,
+                   frq::timer_wheel& timers,
+                   frq::timer_wheel::time_point deadline,
+                   std::optional<retainment_type>& result,
+                   bool& done) -> frq::task<> {
+    result = co_await queue.get_until(deadline, timers);
+    done = true;
+  }(queue, timers, start + 5ms, result, done);
+
+  getter.start();
+  EXPECT_FALSE(done);
+
+  timers.advance(start + 5ms);
+  EXPECT_TRUE(done);
+  EXPECT_FALSE(result.has_value());
+
+  frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}, 1.0F));
+
+  auto item = frq::sync_wait(queue.get());
+  EXPECT_EQ(1.0F, item.value());
+
+  frq::sync_wait(item.finalize());
+}
+
+TEST(cancel_forque_tests, stop_detaches_waiting_consumer) {
+  static_queue queue{};
+
+  std::stop_source source{};
+  bool cancelled{false};
+
+  auto getter = [](static_queue& queue,
+                   std::stop_token stop,
+                   bool& cancelled) -> frq::task<> {
+    try {
+      co_await queue.get(std::move(stop));
+    }
+    catch (frq::cancelled const&) {
+      cancelled = true;
+    }
+  }(queue, source.get_token(), cancelled);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  source.request_stop();
+  EXPECT_TRUE(cancelled);
+
+  frq::sync_wait(
+      queue.reserve(static_tag{frq::construct_tag_default, 1, 1.0F}, 1.0F));
+
+  auto item = frq::sync_wait(queue.get());
+  EXPECT_EQ(1.0F, item.value());
+
+  frq::sync_wait(item.finalize());
+}
+
+TEST(multi_thread_forque_tests, serves_blocking_consumer) {
+  using blocking_runque = frq::make_runque_t<frq::fifo_order,
+                                             frq::multi_thread_model,
+                                             retainment_type,
+                                             std::allocator<retainment_type>>;
+  using blocking_queue = frq::forque<item_type, blocking_runque, static_tag>;
+
+  blocking_queue queue{};
+  static_tag const tag{frq::construct_tag_default, 1, 1.0F};
+
+  auto reservation = frq::sync_wait(queue.reserve(tag));
+  frq::sync_wait(queue.reserve(tag, 2.0F));
+
+  std::optional<item_type> first{};
+  std::thread consumer{[&queue, &first] {
+    auto item = queue.get();
+    first = item.value();
+
+    frq::sync_wait(item.finalize());
+  }};
+
+  frq::sync_wait(reservation.release(1.0F));
+  consumer.join();
+
+  EXPECT_EQ(1.0F, first);
+
+  auto second = queue.get();
+  EXPECT_EQ(2.0F, second.value());
+
+  frq::sync_wait(second.finalize());
+  frq::sync_wait(queue.interrupt());
+
+  EXPECT_THROW(queue.get(), frq::interrupted);
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
@@ -0,0 +1,78 @@
+
+#include "interval_tree.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using range_type = frq::interval<int>;
+using tree_type = frq::detail::interval_tree<int, int>;
+
+class interval_tree_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  std::vector<int> overlaps(range_type const& range) {
+    std::vector<int> result;
+    tree_.overlaps(range,
+                   [&result](auto& node) { result.push_back(node.payload_); });
+    return result;
+  }
+
+  tree_type tree_{};
+};
+
+TEST(interval_tests, half_open_overlap) {
+  EXPECT_TRUE((range_type{0, 10}.overlaps(range_type{9, 20})));
+  EXPECT_FALSE((range_type{0, 10}.overlaps(range_type{10, 20})));
+  EXPECT_FALSE((range_type{10, 20}.overlaps(range_type{0, 10})));
+  EXPECT_TRUE((range_type{0, 30}.overlaps(range_type{10, 20})));
+}
+
+TEST_F(interval_tree_tests, is_empty_when_empty) {
+  EXPECT_TRUE(tree_.empty());
+  EXPECT_TRUE(overlaps(range_type{0, 100}).empty());
+}
+
+TEST_F(interval_tree_tests, finds_overlapping_in_order) {
+  tree_.insert(range_type{20, 30}, 1);
+  tree_.insert(range_type{0, 10}, 2);
+  tree_.insert(range_type{5, 25}, 3);
+  tree_.insert(range_type{40, 50}, 4);
+
+  EXPECT_EQ((std::vector<int>{2, 3, 1, 4}), overlaps(range_type{0, 100}));
+  EXPECT_EQ((std::vector<int>{3, 1}), overlaps(range_type{10, 40}));
+  EXPECT_EQ((std::vector<int>{}), overlaps(range_type{30, 40}));
+  EXPECT_EQ((std::vector<int>{4}), overlaps(range_type{45, 46}));
+}
+
+TEST_F(interval_tree_tests, erased_is_not_found) {
+  auto node1 = tree_.insert(range_type{0, 10}, 1);
+  auto node2 = tree_.insert(range_type{5, 15}, 2);
+
+  tree_.erase(node1);
+  EXPECT_EQ((std::vector<int>{2}), overlaps(range_type{0, 10}));
+
+  tree_.erase(node2);
+  EXPECT_TRUE(tree_.empty());
+}
+
+TEST_F(interval_tree_tests, many_ranges) {
+  std::vector<tree_type::iterator> nodes;
+  for (int i = 0; i < 100; ++i) {
+    nodes.push_back(tree_.insert(range_type{i, i + 3}, i));
+  }
+
+  EXPECT_EQ((std::vector<int>{48, 49, 50}), overlaps(range_type{50, 51}));
+
+  for (int i = 0; i < 100; i += 2) {
+    tree_.erase(nodes[i]);
+  }
+
+  EXPECT_EQ((std::vector<int>{49}), overlaps(range_type{50, 51}));
+
+  int count{0};
+  tree_.for_each([&count](auto& /*unused*/) { ++count; });
+  EXPECT_EQ(50, count);
+}
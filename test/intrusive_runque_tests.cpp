@@ -0,0 +1,262 @@
+
+#include "intrusive_runque.hpp"
+#include "sync_wait.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
+
+namespace {
+using retainment_type = frq::retainment<int>;
+using tag_type = frq::stag_t<int, int>;
+
+template<typename Order, typename... Rest>
+using intrusive_queue =
+    frq::forque<int,
+                frq::make_runque_t<Order,
+                                   frq::coro_thread_model,
+                                   retainment_type,
+                                   std::allocator<retainment_type>,
+                                   Rest...>,
+                tag_type>;
+
+using dynamic_queue =
+    frq::forque<int,
+                frq::make_runque_t<frq::inherited_priority_order,
+                                   frq::coro_thread_model,
+                                   retainment_type,
+                                   std::allocator<retainment_type>>,
+                frq::dtag<>>;
+
+template<typename Queue>
+std::vector<int> drain(Queue& queue, std::vector<int> const& values) {
+  for (auto value : values) {
+    frq::sync_wait(
+        queue.reserve(tag_type{frq::construct_tag_default, value, 0}, value));
+  }
+
+  std::vector<retainment_type> ready{};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ready.push_back(frq::sync_wait(queue.get()));
+  }
+
+  std::vector<int> result{};
+  for (auto& item : ready) {
+    result.push_back(item.value());
+    frq::sync_wait(item.finalize());
+  }
+
+  return result;
+}
+} // namespace
+
+TEST(intrusive_runque_tests, fifo_order) {
+  intrusive_queue<frq::intrusive_fifo_order> queue{};
+
+  EXPECT_EQ((std::vector<int>{3, 1, 4, 5, 2}),
+            drain(queue, {3, 1, 4, 5, 2}));
+}
+
+TEST(intrusive_runque_tests, lifo_order) {
+  intrusive_queue<frq::intrusive_lifo_order> queue{};
+
+  EXPECT_EQ((std::vector<int>{2, 5, 4, 1, 3}),
+            drain(queue, {3, 1, 4, 5, 2}));
+}
+
+TEST(intrusive_runque_tests, priority_order) {
+  intrusive_queue<frq::intrusive_priority_order> queue{};
+
+  EXPECT_EQ((std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}),
+            drain(queue, {3, 1, 4, 9, 0, 2, 6, 5, 8, 7}));
+}
+
+TEST(intrusive_runque_tests, priority_custom_less) {
+  intrusive_queue<frq::intrusive_priority_order, std::greater<int>> queue{};
+
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6}),
+            drain(queue, {5, 3, 6, 0, 2, 4, 1}));
+}
+
+TEST(intrusive_runque_tests, serialized_siblings) {
+  intrusive_queue<frq::intrusive_fifo_order> queue{};
+
+  tag_type const tag{frq::construct_tag_default, 1, 1};
+
+  frq::sync_wait(queue.reserve(tag, 1));
+  frq::sync_wait(queue.reserve(tag, 2));
+
+  auto first = frq::sync_wait(queue.get());
+  EXPECT_EQ(1, first.value());
+
+  frq::sync_wait(first.finalize());
+
+  auto second = frq::sync_wait(queue.get());
+  EXPECT_EQ(2, second.value());
+
+  frq::sync_wait(second.finalize());
+}
+
+TEST(intrusive_runque_tests, destroy_with_pending_items) {
+  auto queue = std::make_unique<intrusive_queue<frq::intrusive_lifo_order>>();
+
+  for (int i = 0; i < 3; ++i) {
+    frq::sync_wait(
+        queue->reserve(tag_type{frq::construct_tag_default, i, 0}, i));
+  }
+
+  queue.reset();
+}
+
+TEST(intrusive_runque_tests, reserve_time_priority) {
+  intrusive_queue<frq::inherited_priority_order> queue{};
+
+  frq::sync_wait(queue.reserve(
+      tag_type{frq::construct_tag_default, 1, 0}, 1, frq::item_priority{1}));
+  frq::sync_wait(queue.reserve(
+      tag_type{frq::construct_tag_default, 2, 0}, 2, frq::item_priority{5}));
+  frq::sync_wait(queue.reserve(
+      tag_type{frq::construct_tag_default, 3, 0}, 3, frq::item_priority{3}));
+  frq::sync_wait(queue.reserve(tag_type{frq::construct_tag_default, 4, 0}, 4));
+
+  std::vector<int> result{};
+  for (int i = 0; i < 4; ++i) {
+    auto item = frq::sync_wait(queue.get());
+    result.push_back(item.value());
+    frq::sync_wait(item.finalize());
+  }
+
+  EXPECT_EQ((std::vector<int>{2, 3, 1, 4}), result);
+}
+
+TEST(intrusive_runque_tests, blocked_item_boosts_queued_sibling) {
+  intrusive_queue<frq::inherited_priority_order> queue{};
+
+  tag_type const blocked{frq::construct_tag_default, 1, 1};
+
+  frq::sync_wait(queue.reserve(blocked, 1));
+  frq::sync_wait(queue.reserve(
+      tag_type{frq::construct_tag_default, 2, 0}, 2, frq::item_priority{5}));
+  frq::sync_wait(queue.reserve(blocked, 3, frq::item_priority{10}));
+
+  auto first = frq::sync_wait(queue.get());
+  EXPECT_EQ(1, first.value());
+  frq::sync_wait(first.finalize());
+
+  auto second = frq::sync_wait(queue.get());
+  EXPECT_EQ(3, second.value());
+  frq::sync_wait(second.finalize());
+
+  auto third = frq::sync_wait(queue.get());
+  EXPECT_EQ(2, third.value());
+  frq::sync_wait(third.finalize());
+}
+
+TEST(intrusive_runque_tests, blocked_item_boosts_pending_reservation) {
+  intrusive_queue<frq::inherited_priority_order> queue{};
+
+  tag_type const blocked{frq::construct_tag_default, 1, 1};
+
+  auto pending = frq::sync_wait(queue.reserve(blocked));
+  frq::sync_wait(queue.reserve(
+      tag_type{frq::construct_tag_default, 2, 0}, 2, frq::item_priority{5}));
+  frq::sync_wait(queue.reserve(blocked, 3, frq::item_priority{10}));
+
+  frq::sync_wait(pending.release(1));
+
+  auto first = frq::sync_wait(queue.get());
+  auto second = frq::sync_wait(queue.get());
+
+  EXPECT_EQ(1, first.value());
+  EXPECT_EQ(2, second.value());
+
+  frq::sync_wait(first.finalize());
+  frq::sync_wait(second.finalize());
+
+  auto third = frq::sync_wait(queue.get());
+  EXPECT_EQ(3, third.value());
+  frq::sync_wait(third.finalize());
+}
+
+TEST(intrusive_runque_tests, blocked_item_boosts_ancestor) {
+  dynamic_queue queue{};
+
+  frq::sync_wait(
+      queue.reserve(frq::dtag<>{frq::construct_tag_default, 1}, 1));
+  frq::sync_wait(queue.reserve(frq::dtag<>{frq::construct_tag_default, 2},
+                               2,
+                               frq::item_priority{5}));
+  frq::sync_wait(queue.reserve(frq::dtag<>{frq::construct_tag_default, 1, 2},
+                               3,
+                               frq::item_priority{10}));
+
+  auto first = frq::sync_wait(queue.get());
+  EXPECT_EQ(1, first.value());
+  frq::sync_wait(first.finalize());
+
+  auto second = frq::sync_wait(queue.get());
+  EXPECT_EQ(3, second.value());
+  frq::sync_wait(second.finalize());
+
+  auto third = frq::sync_wait(queue.get());
+  EXPECT_EQ(2, third.value());
+  frq::sync_wait(third.finalize());
+}
+
+TEST(intrusive_runque_tests, blocked_prefix_boosts_descendant) {
+  dynamic_queue queue{};
+
+  frq::sync_wait(
+      queue.reserve(frq::dtag<>{frq::construct_tag_default, 1, 2, 3}, 1));
+  frq::sync_wait(queue.reserve(frq::dtag<>{frq::construct_tag_default, 2},
+                               2,
+                               frq::item_priority{5}));
+  frq::sync_wait(queue.reserve(
+      frq::dtag<>{frq::construct_tag_default, 1}, 3, frq::item_priority{10}));
+
+  auto first = frq::sync_wait(queue.get());
+  EXPECT_EQ(1, first.value());
+  frq::sync_wait(first.finalize());
+
+  auto second = frq::sync_wait(queue.get());
+  EXPECT_EQ(3, second.value());
+  frq::sync_wait(second.finalize());
+
+  auto third = frq::sync_wait(queue.get());
+  EXPECT_EQ(2, third.value());
+  frq::sync_wait(third.finalize());
+}
+
+TEST(intrusive_runque_tests, blocked_prefix_boosts_forked_descendants) {
+  dynamic_queue queue{};
+
+  frq::sync_wait(
+      queue.reserve(frq::dtag<>{frq::construct_tag_default, 1, 2}, 1));
+  frq::sync_wait(
+      queue.reserve(frq::dtag<>{frq::construct_tag_default, 1, 3}, 2));
+  frq::sync_wait(queue.reserve(frq::dtag<>{frq::construct_tag_default, 4},
+                               3,
+                               frq::item_priority{5}));
+  frq::sync_wait(queue.reserve(
+      frq::dtag<>{frq::construct_tag_default, 1}, 4, frq::item_priority{10}));
+
+  auto first = frq::sync_wait(queue.get());
+  auto second = frq::sync_wait(queue.get());
+
+  EXPECT_EQ(3, first.value() + second.value());
+
+  frq::sync_wait(first.finalize());
+  frq::sync_wait(second.finalize());
+
+  auto third = frq::sync_wait(queue.get());
+  EXPECT_EQ(4, third.value());
+  frq::sync_wait(third.finalize());
+
+  auto fourth = frq::sync_wait(queue.get());
+  EXPECT_EQ(3, fourth.value());
+  frq::sync_wait(fourth.finalize());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
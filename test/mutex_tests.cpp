@@ -5,6 +5,8 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <optional>
 #include <thread>
 
 class mutex_unlocked_tests : public testing::Test {
@@ -25,6 +27,11 @@ TEST_F(mutex_unlocked_tests, unlock_unlocked_mutex) {
   EXPECT_DEATH(mutex_.unlock(), "is_free");
 }
 
+TEST_F(mutex_unlocked_tests, lock_for_unlocked_mutex) {
+  EXPECT_TRUE(frq::sync_wait(mutex_.lock_for(std::chrono::seconds{1})));
+  EXPECT_FALSE(mutex_.try_lock());
+}
+
 class mutex_locked_tests : public mutex_unlocked_tests {
 protected:
   void SetUp() override {
@@ -48,6 +55,58 @@ TEST_F(mutex_locked_tests, guarded_unlock_mutex) {
   EXPECT_TRUE(mutex_.try_lock());
 }
 
+TEST_F(mutex_locked_tests, lock_until_past_deadline) {
+  auto deadline = frq::timer_wheel::clock_type::now();
+
+  EXPECT_FALSE(frq::sync_wait(mutex_.lock_until(deadline)));
+}
+
+TEST_F(mutex_locked_tests, lock_until_expires) {
+  using namespace std::chrono_literals;
+
+  auto start = frq::timer_wheel::clock_type::now() + 1h;
+  frq::timer_wheel timers{1ms, start};
+
+  std::optional<bool> result{};
+  auto locker = [](frq::mutex& mutex,
+                   frq::timer_wheel& timers,
+                   frq::timer_wheel::time_point deadline,
+                   std::optional<bool>& result) -> frq::task<> {
+    result = co_await mutex.lock_until(deadline, timers);
+  }(mutex_, timers, start + 5ms, result);
+
+  locker.start();
+  EXPECT_FALSE(result.has_value());
+
+  timers.advance(start + 5ms);
+  EXPECT_EQ(false, result);
+
+  mutex_.unlock();
+  EXPECT_TRUE(mutex_.try_lock());
+}
+
+TEST_F(mutex_locked_tests, lock_until_before_unlock) {
+  using namespace std::chrono_literals;
+
+  auto start = frq::timer_wheel::clock_type::now();
+  frq::timer_wheel timers{1ms, start};
+
+  std::optional<bool> result{};
+  auto locker = [](frq::mutex& mutex,
+                   frq::timer_wheel& timers,
+                   frq::timer_wheel::time_point deadline,
+                   std::optional<bool>& result) -> frq::task<> {
+    result = co_await mutex.lock_until(deadline, timers);
+  }(mutex_, timers, start + 1h, result);
+
+  locker.start();
+  mutex_.unlock();
+
+  EXPECT_EQ(true, result);
+  EXPECT_TRUE(timers.empty());
+  EXPECT_FALSE(mutex_.try_lock());
+}
+
 class mutex_multithreaded_tests : public testing::Test {
 protected:
   void SetUp() override {
@@ -98,4 +157,16 @@ TEST_F(mutex_multithreaded_tests, mutex_guard) {
   });
 }
 
+TEST_F(mutex_multithreaded_tests, mutex_timed) {
+  wrapper(8, 1000, [this]() -> frq::task<> {
+    auto acquired = co_await mutex_.lock_for(std::chrono::microseconds{100});
+    if (acquired) {
+      EXPECT_EQ(1, ++counter_);
+      EXPECT_EQ(0, --counter_);
+
+      mutex_.unlock();
+    }
+  });
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
@@ -0,0 +1,123 @@
+
+#include "forque.hpp"
+#include "poller.hpp"
+#include "sync_wait.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
+
+namespace {
+using item_type = int;
+using retainment_type = frq::retainment<item_type>;
+
+using runque_type = frq::make_runque_t<frq::fifo_order,
+                                       frq::coro_thread_model,
+                                       retainment_type,
+                                       std::allocator<retainment_type>>;
+
+using mpmc_runque_type =
+    frq::make_runque_t<frq::mpmc_fifo_order,
+                       frq::coro_thread_model,
+                       retainment_type,
+                       std::allocator<retainment_type>>;
+
+using tag_type = frq::stag_t<int>;
+
+using queue_type = frq::forque<item_type, runque_type, tag_type>;
+using mpmc_queue_type = frq::forque<item_type, mpmc_runque_type, tag_type>;
+
+using int_runque =
+    frq::runque<frq::mpmc_runque_queue<int>, frq::coro_thread_model>;
+
+static_assert(frq::pollable<queue_type>);
+static_assert(frq::pollable<int_runque>);
+
+template<typename Queue>
+void reserve(Queue& queue, int key, int value) {
+  frq::sync_wait(
+      queue.reserve(tag_type{frq::construct_tag_default, key}, value));
+}
+} // namespace
+
+TEST(poller_tests, empty_sources) {
+  queue_type first{};
+  mpmc_queue_type second{};
+
+  frq::poller poller{first, second};
+
+  EXPECT_FALSE(poller.poll([](auto&& /*unused*/) { FAIL(); }));
+}
+
+TEST(poller_tests, takes_from_any_source) {
+  queue_type first{};
+  mpmc_queue_type second{};
+
+  reserve(second, 1, 2);
+
+  frq::poller poller{first, second};
+
+  int result{0};
+  EXPECT_TRUE(poller.poll([&result](auto&& item) {
+    result = item.value();
+    frq::sync_wait(item.finalize());
+  }));
+
+  EXPECT_EQ(2, result);
+}
+
+TEST(poller_tests, round_robin_between_sources) {
+  queue_type first{};
+  mpmc_queue_type second{};
+
+  reserve(first, 1, 1);
+  reserve(first, 2, 2);
+  reserve(second, 1, 3);
+  reserve(second, 2, 4);
+
+  frq::poller poller{first, second};
+
+  std::vector<int> results{};
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(poller.poll([&results](auto&& item) {
+      results.push_back(item.value());
+      frq::sync_wait(item.finalize());
+    }));
+  }
+
+  EXPECT_EQ((std::vector<int>{1, 3, 2, 4}), results);
+}
+
+TEST(poller_tests, busy_poll_until_stopped) {
+  constexpr int item_count = 1000;
+
+  int_runque first{};
+  int_runque second{};
+
+  std::thread producer{[&first, &second] {
+    for (int i = 1; i <= item_count; ++i) {
+      frq::sync_wait((i % 2 == 0 ? first : second).put(int{i}));
+    }
+  }};
+
+  long sum{0};
+  int taken{0};
+
+  frq::poller poller{first, second};
+  poller.run(
+      [&sum, &taken](int item) {
+        sum += item;
+        ++taken;
+      },
+      [&taken] { return taken == item_count; });
+
+  producer.join();
+
+  EXPECT_EQ(item_count * (item_count + 1L) / 2, sum);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
@@ -0,0 +1,231 @@
+
+#include "forque.hpp"
+#include "rate_limited_runque.hpp"
+#include "sync_wait.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
+
+namespace {
+struct limited_item {
+  int customer_;
+  int id_;
+};
+
+struct customer_key {
+  inline int operator()(limited_item const& item) const noexcept {
+    return item.customer_;
+  }
+};
+
+using inner_runque = frq::make_runque_t<frq::fifo_order,
+                                        frq::coro_thread_model,
+                                        limited_item,
+                                        std::allocator<limited_item>>;
+
+using limited_runque = frq::rate_limited_runque<inner_runque, customer_key>;
+
+static_assert(frq::runlike<limited_runque>);
+
+class deferred_executor {
+public:
+  void post(std::coroutine_handle<> handle) {
+    std::lock_guard guard{lock_};
+    handles_.push_back(handle);
+  }
+
+  std::size_t run() {
+    std::vector<std::coroutine_handle<>> handles{};
+    {
+      std::lock_guard guard{lock_};
+      handles.swap(handles_);
+    }
+
+    for (auto handle : handles) {
+      handle.resume();
+    }
+
+    return handles.size();
+  }
+
+private:
+  std::mutex lock_;
+  std::vector<std::coroutine_handle<>> handles_;
+};
+} // namespace
+
+TEST(rate_limited_runque_tests, unlimited_key_passes_through) {
+  limited_runque runque{};
+
+  frq::sync_wait(runque.put(limited_item{1, 1}));
+
+  EXPECT_EQ(0, runque.held());
+  EXPECT_EQ(1, frq::sync_wait(runque.get()).id_);
+}
+
+TEST(rate_limited_runque_tests, burst_passes_through) {
+  limited_runque runque{};
+  runque.set_rate(1, 1.0, 3.0);
+
+  for (int i = 0; i < 3; ++i) {
+    frq::sync_wait(runque.put(limited_item{1, i}));
+  }
+
+  EXPECT_EQ(0, runque.held());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, frq::sync_wait(runque.get()).id_);
+  }
+}
+
+TEST(rate_limited_runque_tests, holds_items_over_rate) {
+  limited_runque runque{};
+  runque.set_rate(1, 20.0, 1.0);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 3; ++i) {
+    frq::sync_wait(runque.put(limited_item{1, i}));
+  }
+
+  EXPECT_EQ(2, runque.held());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, frq::sync_wait(runque.get()).id_);
+  }
+
+  EXPECT_LE(std::chrono::milliseconds{90},
+            std::chrono::steady_clock::now() - start);
+  EXPECT_EQ(0, runque.held());
+}
+
+TEST(rate_limited_runque_tests, other_keys_are_not_held) {
+  limited_runque runque{};
+  runque.set_rate(1, 0.1, 1.0);
+
+  frq::sync_wait(runque.put(limited_item{1, 0}));
+  frq::sync_wait(runque.put(limited_item{1, 1}));
+  frq::sync_wait(runque.put(limited_item{2, 2}));
+
+  EXPECT_EQ(1, runque.held());
+
+  EXPECT_EQ(0, frq::sync_wait(runque.get()).id_);
+  EXPECT_EQ(2, frq::sync_wait(runque.get()).id_);
+}
+
+TEST(rate_limited_runque_tests, interrupt_with_held_items) {
+  limited_runque runque{};
+  runque.set_rate(1, 0.1, 1.0);
+
+  frq::sync_wait(runque.put(limited_item{1, 0}));
+  frq::sync_wait(runque.put(limited_item{1, 1}));
+
+  frq::sync_wait(runque.interrupt());
+
+  EXPECT_THROW(frq::sync_wait(runque.put(limited_item{2, 2})),
+               frq::interrupted);
+
+  EXPECT_EQ(0, runque.held());
+  EXPECT_EQ(0, runque.dropped());
+
+  auto& queue = runque.get_runque().get_queue();
+  ASSERT_FALSE(queue.empty());
+  EXPECT_EQ(0, queue.pop().id_);
+  ASSERT_FALSE(queue.empty());
+  EXPECT_EQ(1, queue.pop().id_);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(rate_limited_runque_tests, releases_on_dispatch_executor) {
+  deferred_executor executor{};
+  limited_runque runque{executor};
+  runque.set_rate(1, 20.0, 1.0);
+
+  frq::sync_wait(runque.put(limited_item{1, 0}));
+  frq::sync_wait(runque.put(limited_item{1, 1}));
+  EXPECT_EQ(0, frq::sync_wait(runque.get()).id_);
+
+  int result{-1};
+  std::thread::id resumed{};
+  auto getter = [](limited_runque& runque,
+                   int& result,
+                   std::thread::id& resumed) -> frq::task<> {
+    result = (co_await runque.get()).id_;
+    resumed = std::this_thread::get_id();
+  }(runque, result, resumed);
+
+  getter.start();
+
+  while (runque.held() != 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  std::size_t posted{0};
+  while (posted == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    EXPECT_EQ(-1, result);
+    posted = executor.run();
+  }
+
+  EXPECT_EQ(1, posted);
+  EXPECT_EQ(1, result);
+  EXPECT_EQ(std::this_thread::get_id(), resumed);
+}
+
+TEST(rate_limited_runque_tests, put_many_holds_items_over_rate) {
+  limited_runque runque{};
+  runque.set_rate(1, 1.0, 1.0);
+
+  std::vector<limited_item> values{{1, 1}, {2, 2}, {1, 3}, {2, 4}};
+  frq::sync_wait(runque.put_many(values));
+
+  EXPECT_EQ(1, runque.held());
+  EXPECT_EQ(1, frq::sync_wait(runque.get()).id_);
+  EXPECT_EQ(2, frq::sync_wait(runque.get()).id_);
+  EXPECT_EQ(4, frq::sync_wait(runque.get()).id_);
+}
+
+TEST(rate_limited_runque_tests, serves_forque) {
+  using retainment_type = frq::retainment<int>;
+  using tag_type = frq::stag_t<int, int>;
+
+  struct tenant_key {
+    inline int operator()(int value) const noexcept {
+      return value / 10;
+    }
+  };
+
+  using fifo_runque = frq::make_runque_t<frq::fifo_order,
+                                         frq::coro_thread_model,
+                                         retainment_type,
+                                         std::allocator<retainment_type>>;
+
+  using runque_type = frq::rate_limited_runque<fifo_runque, tenant_key>;
+
+  frq::forque<int, runque_type, tag_type> queue{};
+  queue.get_runque().set_rate(1, 20.0, 1.0);
+
+  frq::sync_wait(queue.reserve(tag_type{frq::construct_tag_default, 1, 1}, 10));
+  frq::sync_wait(queue.reserve(tag_type{frq::construct_tag_default, 1, 2}, 11));
+  frq::sync_wait(queue.reserve(tag_type{frq::construct_tag_default, 2, 1}, 20));
+
+  EXPECT_EQ(1, queue.get_runque().held());
+
+  std::vector<int> values{};
+  for (int i = 0; i < 3; ++i) {
+    auto item = frq::sync_wait(queue.get());
+    values.push_back(item.value());
+    frq::sync_wait(item.finalize());
+  }
+
+  EXPECT_EQ((std::vector<int>{10, 20, 11}), values);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
@@ -4,6 +4,21 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <limits>
+#include <new>
+#include <optional>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
 namespace {
 class test_item {
 public:
@@ -24,6 +39,10 @@ public:
 
   constexpr auto operator<=>(const test_item&) const = default;
 
+  constexpr int key() const noexcept {
+    return v1_;
+  }
+
 private:
   int v1_{};
   int v2_{};
@@ -96,6 +115,185 @@ TEST_F(runque_queue_priority_nonempty_test, push_before_top) {
   EXPECT_EQ(expected, queue_.pop());
 }
 
+// keyed priority queue tests
+
+struct test_item_key {
+  inline int operator()(test_item const& item) const noexcept {
+    return item.key();
+  }
+};
+
+class runque_queue_keyed_priority_test : public testing::Test {
+protected:
+  void SetUp() override {
+    queue_.push(5, 5);
+  }
+
+  frq::keyed_priority_runque_queue<test_item, test_item_key> queue_{};
+};
+
+TEST_F(runque_queue_keyed_priority_test, is_empty_after_pop_last) {
+  queue_.pop();
+
+  EXPECT_TRUE(queue_.empty());
+}
+
+TEST_F(runque_queue_keyed_priority_test, push_after_top) {
+  constexpr test_item expected{5, 5};
+
+  queue_.push(4, 4);
+
+  EXPECT_EQ(expected, queue_.pop());
+}
+
+TEST_F(runque_queue_keyed_priority_test, push_before_top) {
+  constexpr test_item expected{6, 6};
+
+  queue_.push(6, 6);
+
+  EXPECT_EQ(expected, queue_.pop());
+}
+
+TEST(runque_queue_keyed_priority_tests, matches_priority_queue) {
+  frq::keyed_priority_runque_queue<int, std::identity> keyed{};
+  std::priority_queue<int> reference{};
+
+  std::mt19937 rng{7};
+  std::uniform_int_distribution<int> value{0, 1000};
+
+  for (int round = 0; round < 2000; ++round) {
+    if (reference.empty() || value(rng) % 3 != 0) {
+      auto item = value(rng);
+      keyed.push(item);
+      reference.push(item);
+    }
+    else {
+      EXPECT_EQ(reference.top(), keyed.pop());
+      reference.pop();
+    }
+  }
+
+  while (!reference.empty()) {
+    EXPECT_EQ(reference.top(), keyed.pop());
+    reference.pop();
+  }
+
+  EXPECT_TRUE(keyed.empty());
+}
+
+TEST(runque_queue_keyed_priority_tests, custom_less) {
+  frq::keyed_priority_runque_queue<int,
+                                   std::identity,
+                                   std::allocator<int>,
+                                   std::greater<>>
+      queue{};
+
+  for (auto item : {4, 1, 3, 0, 2}) {
+    queue.push(item);
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, queue.pop());
+  }
+}
+
+// bucket priority queue tests
+
+struct test_item_level {
+  inline int operator()(test_item const& item) const noexcept {
+    return item.key() % 64;
+  }
+};
+
+class runque_queue_bucket_priority_test : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  frq::bucket_priority_runque_queue<test_item, test_item_level> queue_{};
+};
+
+TEST_F(runque_queue_bucket_priority_test, is_empty_when_empty) {
+  EXPECT_TRUE(queue_.empty());
+}
+
+TEST_F(runque_queue_bucket_priority_test, is_empty_after_pop_last) {
+  queue_.push(5, 5);
+  queue_.pop();
+
+  EXPECT_TRUE(queue_.empty());
+}
+
+TEST_F(runque_queue_bucket_priority_test, highest_level_first) {
+  queue_.push(5, 5);
+  queue_.push(63, 63);
+  queue_.push(0, 0);
+
+  EXPECT_EQ((test_item{63, 63}), queue_.pop());
+  EXPECT_EQ((test_item{5, 5}), queue_.pop());
+  EXPECT_EQ((test_item{0, 0}), queue_.pop());
+}
+
+TEST_F(runque_queue_bucket_priority_test, fifo_within_level) {
+  queue_.push(7, 1);
+  queue_.push(9, 1);
+  queue_.push(7, 2);
+  queue_.push(7, 3);
+
+  EXPECT_EQ((test_item{9, 1}), queue_.pop());
+  EXPECT_EQ((test_item{7, 1}), queue_.pop());
+  EXPECT_EQ((test_item{7, 2}), queue_.pop());
+
+  queue_.push(7, 4);
+
+  EXPECT_EQ((test_item{7, 3}), queue_.pop());
+  EXPECT_EQ((test_item{7, 4}), queue_.pop());
+  EXPECT_TRUE(queue_.empty());
+}
+
+struct test_item_raw_level {
+  inline int operator()(test_item const& item) const noexcept {
+    return item.key();
+  }
+};
+
+TEST(runque_bucket_priority_tests, out_of_range_levels_saturate) {
+  frq::bucket_priority_runque_queue<test_item,
+                                    test_item_raw_level,
+                                    std::allocator<test_item>,
+                                    8>
+      queue{};
+
+  queue.push(3, 1);
+  queue.push(-5, 2);
+  queue.push(64, 3);
+  queue.push(7, 4);
+  queue.push(0, 5);
+
+  EXPECT_EQ((test_item{64, 3}), queue.pop());
+  EXPECT_EQ((test_item{7, 4}), queue.pop());
+  EXPECT_EQ((test_item{3, 1}), queue.pop());
+  EXPECT_EQ((test_item{-5, 2}), queue.pop());
+  EXPECT_EQ((test_item{0, 5}), queue.pop());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(runque_bucket_priority_tests, make_runque) {
+  frq::make_runque_t<frq::bucket_priority_order,
+                     frq::single_thread_model,
+                     test_item,
+                     std::allocator<test_item>,
+                     test_item_level>
+      runque{};
+
+  runque.put(1, 1);
+  runque.put(2, 2);
+
+  EXPECT_EQ((test_item{2, 2}), runque.get());
+  EXPECT_EQ((test_item{1, 1}), runque.get());
+  EXPECT_FALSE(runque.get().has_value());
+}
+
 // fifo queue tests
 
 class runque_queue_fifo_empty_test : public testing::Test {
@@ -208,141 +406,1924 @@ TEST_F(runque_queue_lifo_nonempty_test, push_to_nonempty) {
   EXPECT_EQ(expected, queue_.pop());
 }
 
-// runque single threaded
+// mpmc queue tests
 
-class runque_single_threaded_empty_tests : public testing::Test {
+class runque_queue_mpmc_empty_test : public testing::Test {
 protected:
   void SetUp() override {
   }
 
-  frq::runque<frq::fifo_runque_queue<test_item>, frq::single_thread_model>
-      runque_{};
+  frq::mpmc_runque_queue<test_item> queue_{};
 };
 
-TEST_F(runque_single_threaded_empty_tests, get_from_empty) {
-  auto result = runque_.get();
+TEST_F(runque_queue_mpmc_empty_test, is_empty_when_empty) {
+  EXPECT_TRUE(queue_.empty());
+}
 
-  EXPECT_FALSE(result.has_value());
+TEST_F(runque_queue_mpmc_empty_test, try_pop_from_empty) {
+  EXPECT_FALSE(queue_.try_pop().has_value());
 }
 
-class runque_single_threaded_interrupted
-    : public runque_single_threaded_empty_tests {
+TEST_F(runque_queue_mpmc_empty_test, move_push_to_empty) {
+  queue_.push({});
+  EXPECT_FALSE(queue_.empty());
+}
+
+TEST_F(runque_queue_mpmc_empty_test, emplace_to_empty) {
+  queue_.push(1, 1);
+  EXPECT_FALSE(queue_.empty());
+}
+
+class runque_queue_mpmc_nonempty_test : public testing::Test {
 protected:
   void SetUp() override {
-    runque_.interrupt();
+    queue_.push(5, 5);
   }
+
+  frq::mpmc_runque_queue<test_item> queue_{};
 };
 
-TEST_F(runque_single_threaded_interrupted, get) {
-  EXPECT_THROW(runque_.get(), frq::interrupted);
+TEST_F(runque_queue_mpmc_nonempty_test, is_empty_after_pop_last) {
+  queue_.pop();
+
+  EXPECT_TRUE(queue_.empty());
 }
 
-TEST_F(runque_single_threaded_interrupted, put) {
-  EXPECT_THROW(runque_.put(1, 1), frq::interrupted);
+TEST_F(runque_queue_mpmc_nonempty_test, push_to_nonempty) {
+  constexpr test_item expected{5, 5};
+
+  queue_.push(6, 6);
+
+  EXPECT_EQ(expected, queue_.pop());
 }
 
-class runque_single_threaded_nonempty_tests : public testing::Test {
-protected:
-  void SetUp() override {
-    runque_.put(1, 1);
+TEST(runque_queue_mpmc_test, full_ring_rejects_push) {
+  frq::mpmc_runque_queue<test_item, std::allocator<test_item>, 4> queue{};
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_push({i, i}));
   }
 
-  frq::runque<frq::fifo_runque_queue<test_item>, frq::single_thread_model>
-      runque_{};
-};
+  test_item rejected{4, 4};
+  EXPECT_FALSE(queue.try_push(std::move(rejected)));
+  EXPECT_EQ((test_item{4, 4}), rejected);
+  EXPECT_THROW(queue.push(5, 5), std::length_error);
 
-TEST_F(runque_single_threaded_nonempty_tests, get_from_nonempty) {
-  constexpr test_item expected{1, 1};
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ((test_item{i, i}), queue.pop());
+  }
 
-  auto result = runque_.get();
+  EXPECT_TRUE(queue.empty());
+}
 
-  EXPECT_EQ(expected, *result);
+TEST(runque_queue_mpmc_test, concurrent_push_pop) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 10000;
+
+  frq::mpmc_runque_queue<int, std::allocator<int>, 64> queue{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&queue] {
+      for (int j = 1; j <= item_count; ++j) {
+        while (!queue.try_push(int{j})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    threads.emplace_back([&queue, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += queue.pop();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+  EXPECT_TRUE(queue.empty());
 }
 
-// runque coro
+// relaxed priority queue tests
 
-class runque_coro_empty_tests : public testing::Test {
-protected:
-  void SetUp() override {
+TEST(runque_queue_relaxed_priority_test, is_empty_when_empty) {
+  frq::relaxed_priority_runque_queue<test_item> queue{};
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+TEST(runque_queue_relaxed_priority_test, single_heap_is_strict) {
+  frq::relaxed_priority_runque_queue<test_item> queue{
+      1, std::allocator<test_item>{}};
+
+  queue.push(2, 2);
+  queue.push(5, 5);
+  queue.push(1, 1);
+  queue.push(4, 4);
+
+  EXPECT_EQ((test_item{5, 5}), queue.pop());
+  EXPECT_EQ((test_item{4, 4}), queue.pop());
+  EXPECT_EQ((test_item{2, 2}), queue.pop());
+  EXPECT_EQ((test_item{1, 1}), queue.pop());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(runque_queue_relaxed_priority_test, pops_every_item) {
+  constexpr int item_count = 1000;
+
+  frq::relaxed_priority_runque_queue<int> queue{8, std::allocator<int>{}};
+  EXPECT_EQ(8, queue.heaps());
+
+  for (int i = 0; i < item_count; ++i) {
+    queue.push(i);
   }
 
-  frq::runque<frq::fifo_runque_queue<test_item>, frq::coro_thread_model>
-      runque_{};
+  std::vector<bool> seen(item_count, false);
+  while (auto item = queue.try_pop()) {
+    EXPECT_FALSE(seen[*item]);
+    seen[*item] = true;
+  }
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(item_count, std::count(seen.begin(), seen.end(), true));
+}
+
+TEST(runque_queue_relaxed_priority_test, concurrent_push_pop) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 10000;
+
+  frq::relaxed_priority_runque_queue<int> queue{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&queue] {
+      for (int j = 1; j <= item_count; ++j) {
+        queue.push(j);
+      }
+    });
+
+    threads.emplace_back([&queue, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += queue.pop();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+  EXPECT_TRUE(queue.empty());
+}
+
+// edf queue tests
+
+namespace {
+using deadline_clock = std::chrono::steady_clock;
+
+struct deadline_item {
+  int id_;
+  deadline_clock::time_point deadline_;
+
+  inline deadline_clock::time_point deadline() const noexcept {
+    return deadline_;
+  }
 };
+} // namespace
 
-TEST_F(runque_coro_empty_tests, get_before_put) {
-  constexpr test_item expected{1, 1};
+TEST(runque_queue_edf_test, earliest_deadline_first) {
+  frq::edf_runque_queue<deadline_item> queue{};
 
-  test_item result;
+  auto now = deadline_clock::now() + std::chrono::hours{1};
 
-  auto getter = [this, &result]() -> frq::task<> {
-    result = std::move(co_await runque_.get());
-  }();
+  queue.push({1, now + std::chrono::seconds{3}});
+  queue.push({2, now + std::chrono::seconds{1}});
+  queue.push({3, now + std::chrono::seconds{4}});
+  queue.push({4, now + std::chrono::seconds{2}});
 
-  std::thread{[&getter]() { getter.start(); }}.join();
+  EXPECT_EQ(2, queue.pop().id_);
+  EXPECT_EQ(4, queue.pop().id_);
+  EXPECT_EQ(1, queue.pop().id_);
+  EXPECT_EQ(3, queue.pop().id_);
+  EXPECT_TRUE(queue.empty());
+}
 
-  frq::sync_wait(runque_.put({1, 1}));
+TEST(runque_queue_edf_test, counts_missed_deadlines) {
+  frq::edf_runque_queue<deadline_item> queue{};
 
-  EXPECT_EQ(expected, result);
+  auto now = deadline_clock::now();
+
+  queue.push({1, now - std::chrono::seconds{1}});
+  queue.push({2, now + std::chrono::hours{1}});
+
+  queue.pop();
+  queue.pop();
+
+  EXPECT_EQ(2, queue.served());
+  EXPECT_EQ(1, queue.missed());
 }
 
-TEST_F(runque_coro_empty_tests, put_before_get) {
-  constexpr test_item expected{1, 1};
+TEST(runque_queue_edf_test, slack_of_item) {
+  using queue_type = frq::edf_runque_queue<deadline_item>;
 
-  frq::sync_wait(runque_.put({1, 1}));
-  test_item const result{frq::sync_wait(runque_.get())};
+  deadline_item const late{1, deadline_clock::now() - std::chrono::hours{1}};
+  deadline_item const early{2, deadline_clock::now() + std::chrono::hours{1}};
 
-  EXPECT_EQ(expected, result);
+  EXPECT_LT(queue_type::slack(late), queue_type::duration::zero());
+  EXPECT_GT(queue_type::slack(early), std::chrono::minutes{59});
 }
 
-TEST_F(runque_coro_empty_tests, get_before_emplace) {
-  constexpr test_item expected{1, 1};
+TEST(runque_queue_edf_test, custom_deadline) {
+  struct by_value {
+    inline deadline_clock::time_point operator()(int value) const noexcept {
+      return deadline_clock::time_point{std::chrono::seconds{value}};
+    }
+  };
+
+  frq::make_runque_t<frq::edf_order,
+                     frq::single_thread_model,
+                     int,
+                     std::allocator<int>,
+                     by_value>
+      runque{};
+
+  runque.put(3);
+  runque.put(1);
+  runque.put(2);
+
+  EXPECT_EQ(1, runque.get());
+  EXPECT_EQ(2, runque.get());
+  EXPECT_EQ(3, runque.get());
+
+  EXPECT_EQ(3, runque.get_queue().missed());
+}
 
-  test_item result;
+TEST(runque_coro_edf_tests, counts_handoff_to_waiting_consumer) {
+  using edf_runque = frq::make_runque_t<frq::edf_order,
+                                        frq::coro_thread_model,
+                                        deadline_item,
+                                        std::allocator<deadline_item>>;
 
-  auto getter = [this, &result]() -> frq::task<> {
-    result = std::move(co_await runque_.get());
-  }();
+  edf_runque runque{};
+  std::vector<int> served{};
+
+  auto getter = [](edf_runque& runque,
+                   std::vector<int>& served) -> frq::task<> {
+    for (auto i = 0; i < 4; ++i) {
+      served.push_back((co_await runque.get()).id_);
+    }
+  }(runque, served);
 
   std::thread{[&getter]() { getter.start(); }}.join();
 
-  frq::sync_wait(runque_.put(1, 1));
+  auto now = deadline_clock::now();
 
-  EXPECT_EQ(expected, result);
+  frq::sync_wait(runque.put(deadline_item{1, now - std::chrono::seconds{1}}));
+  frq::sync_wait(runque.put(2, now + std::chrono::hours{1}));
+
+  std::array<deadline_item, 2> items{
+      deadline_item{3, now + std::chrono::hours{1}},
+      deadline_item{4, now - std::chrono::seconds{1}}};
+  frq::sync_wait(runque.put_many(items));
+
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), served);
+  EXPECT_EQ(4, runque.get_queue().served());
+  EXPECT_EQ(2, runque.get_queue().missed());
 }
 
-TEST_F(runque_coro_empty_tests, empalce_before_get) {
-  constexpr test_item expected{1, 1};
+// fair queue tests
 
-  frq::sync_wait(runque_.put(1, 1));
-  test_item const result{frq::sync_wait(runque_.get())};
+namespace {
+struct tenant_item {
+  int tenant_;
+  int id_;
+  std::size_t cost_{1};
+};
 
-  EXPECT_EQ(expected, result);
+struct tenant_key {
+  inline int operator()(tenant_item const& item) const noexcept {
+    return item.tenant_;
+  }
+};
+
+struct tenant_cost {
+  inline std::size_t operator()(tenant_item const& item) const noexcept {
+    return item.cost_;
+  }
+};
+
+template<typename Queue>
+std::vector<int> drain_tenants(Queue& queue) {
+  std::vector<int> result{};
+  while (!queue.empty()) {
+    result.push_back(queue.pop().tenant_);
+  }
+
+  return result;
 }
+} // namespace
 
-TEST_F(runque_coro_empty_tests, get_before_interrupt) {
-  auto getter = [this]() -> frq::task<> {
-    EXPECT_THROW(co_await runque_.get(), frq::interrupted);
-  }();
+TEST(runque_queue_fair_test, round_robin_between_keys) {
+  frq::fair_runque_queue<tenant_item, tenant_key> queue{};
 
-  std::thread{[&getter]() { getter.start(); }}.join();
+  for (int i = 0; i < 4; ++i) {
+    queue.push({1, i});
+  }
 
-  frq::sync_wait(runque_.interrupt());
+  queue.push({2, 0});
+  queue.push({2, 1});
+
+  EXPECT_EQ(6, queue.size());
+  EXPECT_EQ((std::vector<int>{1, 2, 1, 2, 1, 1}), drain_tenants(queue));
 }
 
-TEST_F(runque_coro_empty_tests, interrupt_before_get) {
-  frq::sync_wait(runque_.interrupt());
-  EXPECT_THROW(frq::sync_wait(runque_.get()), frq::interrupted);
+TEST(runque_queue_fair_test, keeps_order_within_key) {
+  frq::fair_runque_queue<tenant_item, tenant_key> queue{};
+
+  for (int i = 0; i < 4; ++i) {
+    queue.push({1, i});
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, queue.pop().id_);
+  }
+
+  EXPECT_TRUE(queue.empty());
 }
 
-TEST_F(runque_coro_empty_tests, interrupt_before_put) {
-  frq::sync_wait(runque_.interrupt());
-  EXPECT_THROW(frq::sync_wait(runque_.put({1, 1})), frq::interrupted);
+TEST(runque_queue_fair_test, weighted_shares) {
+  frq::fair_runque_queue<tenant_item, tenant_key> queue{};
+
+  queue.set_weight(1, 2);
+  EXPECT_EQ(2, queue.weight(1));
+  EXPECT_EQ(1, queue.weight(2));
+
+  for (int i = 0; i < 4; ++i) {
+    queue.push({1, i});
+    queue.push({2, i});
+  }
+
+  EXPECT_EQ((std::vector<int>{1, 1, 2, 1, 1, 2, 2, 2}), drain_tenants(queue));
 }
 
-TEST_F(runque_coro_empty_tests, interrupt_before_emplace) {
-  frq::sync_wait(runque_.interrupt());
-  EXPECT_THROW(frq::sync_wait(runque_.put(1, 1)), frq::interrupted);
+TEST(runque_queue_fair_test, item_cost) {
+  frq::fair_runque_queue<tenant_item,
+                         tenant_key,
+                         std::allocator<tenant_item>,
+                         tenant_cost>
+      queue{};
+
+  queue.set_weight(1, 2);
+  queue.set_weight(2, 2);
+
+  queue.push({1, 0, 4});
+  queue.push({1, 1, 4});
+  for (int i = 0; i < 4; ++i) {
+    queue.push({2, i, 1});
+  }
+
+  EXPECT_EQ((std::vector<int>{2, 2, 1, 2, 2, 1}), drain_tenants(queue));
+}
+
+TEST(runque_queue_fair_test, coro_runque) {
+  frq::make_runque_t<frq::fair_order,
+                     frq::coro_thread_model,
+                     tenant_item,
+                     std::allocator<tenant_item>,
+                     tenant_key>
+      runque{};
+
+  frq::sync_wait(runque.put(tenant_item{1, 0}));
+  frq::sync_wait(runque.put(tenant_item{1, 1}));
+  frq::sync_wait(runque.put(tenant_item{2, 0}));
+
+  EXPECT_EQ(1, frq::sync_wait(runque.get()).tenant_);
+  EXPECT_EQ(2, frq::sync_wait(runque.get()).tenant_);
+  EXPECT_EQ(1, frq::sync_wait(runque.get()).tenant_);
+}
+
+// aging priority queue tests
+
+namespace {
+struct aging_item {
+  int priority_;
+  int id_;
+  std::chrono::steady_clock::duration age_{};
+
+  inline void set_age(std::chrono::steady_clock::duration age) noexcept {
+    age_ = age;
+  }
+};
+
+struct aging_priority {
+  inline int operator()(aging_item const& item) const noexcept {
+    return item.priority_;
+  }
+};
+
+using aging_queue =
+    frq::aging_priority_runque_queue<aging_item, aging_priority>;
+} // namespace
+
+TEST(runque_queue_aging_test, higher_priority_first) {
+  aging_queue queue{};
+  queue.set_interval(std::chrono::hours{1});
+
+  queue.push(aging_item{1, 1});
+  queue.push(aging_item{3, 2});
+  queue.push(aging_item{2, 3});
+
+  EXPECT_EQ(2, queue.pop().id_);
+  EXPECT_EQ(3, queue.pop().id_);
+  EXPECT_EQ(1, queue.pop().id_);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(runque_queue_aging_test, waiting_items_age) {
+  aging_queue queue{};
+  queue.set_interval(std::chrono::milliseconds{1});
+
+  queue.push(aging_item{1, 1});
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  queue.push(aging_item{5, 2});
+
+  EXPECT_EQ(1, queue.pop().id_);
+  EXPECT_EQ(2, queue.pop().id_);
+}
+
+TEST(runque_queue_aging_test, extreme_priorities_saturate) {
+  aging_queue queue{};
+  queue.set_interval(std::chrono::hours{1});
+
+  queue.push(aging_item{std::numeric_limits<int>::min(), 1});
+  queue.push(aging_item{1, 2});
+  queue.push(aging_item{std::numeric_limits<int>::max(), 3});
+  queue.push(aging_item{-1, 4});
+
+  EXPECT_EQ(3, queue.pop().id_);
+  EXPECT_EQ(2, queue.pop().id_);
+  EXPECT_EQ(4, queue.pop().id_);
+  EXPECT_EQ(1, queue.pop().id_);
+}
+
+TEST(runque_queue_aging_test, reports_age) {
+  aging_queue queue{};
+
+  queue.push(aging_item{1, 1});
+  std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+  EXPECT_LE(std::chrono::milliseconds{5}, queue.pop().age_);
+}
+
+// runque single threaded
+
+class runque_single_threaded_empty_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  frq::runque<frq::fifo_runque_queue<test_item>, frq::single_thread_model>
+      runque_{};
+};
+
+TEST_F(runque_single_threaded_empty_tests, get_from_empty) {
+  auto result = runque_.get();
+
+  EXPECT_FALSE(result.has_value());
+}
+
+class runque_single_threaded_interrupted
+    : public runque_single_threaded_empty_tests {
+protected:
+  void SetUp() override {
+    runque_.interrupt();
+  }
+};
+
+TEST_F(runque_single_threaded_interrupted, get) {
+  EXPECT_THROW(runque_.get(), frq::interrupted);
+}
+
+TEST_F(runque_single_threaded_interrupted, put) {
+  EXPECT_THROW(runque_.put(1, 1), frq::interrupted);
+}
+
+class runque_single_threaded_nonempty_tests : public testing::Test {
+protected:
+  void SetUp() override {
+    runque_.put(1, 1);
+  }
+
+  frq::runque<frq::fifo_runque_queue<test_item>, frq::single_thread_model>
+      runque_{};
+};
+
+TEST_F(runque_single_threaded_nonempty_tests, get_from_nonempty) {
+  constexpr test_item expected{1, 1};
+
+  auto result = runque_.get();
+
+  EXPECT_EQ(expected, *result);
+}
+
+// runque multi threaded
+
+class runque_multi_threaded_empty_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  frq::runque<frq::fifo_runque_queue<test_item>, frq::multi_thread_model>
+      runque_{};
+};
+
+TEST_F(runque_multi_threaded_empty_tests, put_before_get) {
+  constexpr test_item expected{1, 1};
+
+  runque_.put(1, 1);
+
+  EXPECT_EQ(expected, runque_.get());
+}
+
+TEST_F(runque_multi_threaded_empty_tests, get_before_put) {
+  constexpr test_item expected{1, 1};
+
+  test_item result;
+  std::thread getter{[this, &result]() { result = runque_.get(); }};
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  runque_.put({1, 1});
+
+  getter.join();
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_multi_threaded_empty_tests, try_get_from_empty) {
+  EXPECT_FALSE(runque_.try_get().has_value());
+}
+
+TEST_F(runque_multi_threaded_empty_tests, try_get_from_nonempty) {
+  constexpr test_item expected{1, 1};
+
+  runque_.put(1, 1);
+  auto result = runque_.try_get();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(expected, *result);
+}
+
+TEST_F(runque_multi_threaded_empty_tests, try_get_does_not_block_on_lock) {
+  runque_.put(1, 1);
+
+  std::optional<test_item> result{};
+  runque_.with_queue([this, &result](auto& /*unused*/) {
+    std::thread{[this, &result]() { result = runque_.try_get(); }}.join();
+  });
+
+  EXPECT_FALSE(result.has_value());
+  EXPECT_TRUE(runque_.try_get().has_value());
+}
+
+TEST_F(runque_multi_threaded_empty_tests, get_for_times_out) {
+  auto result = runque_.get_for(std::chrono::milliseconds{5});
+
+  EXPECT_FALSE(result.has_value());
+}
+
+TEST_F(runque_multi_threaded_empty_tests, get_for_before_put) {
+  constexpr test_item expected{1, 1};
+
+  std::optional<test_item> result;
+  std::thread getter{[this, &result]() {
+    result = runque_.get_for(std::chrono::seconds{10});
+  }};
+
+  runque_.put(1, 1);
+  getter.join();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(expected, *result);
+}
+
+TEST_F(runque_multi_threaded_empty_tests, get_before_interrupt) {
+  std::thread getter{
+      [this]() { EXPECT_THROW(runque_.get(), frq::interrupted); }};
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  runque_.interrupt();
+
+  getter.join();
+}
+
+TEST_F(runque_multi_threaded_empty_tests, interrupt_before_get) {
+  runque_.interrupt();
+
+  EXPECT_THROW(runque_.get(), frq::interrupted);
+  EXPECT_THROW(runque_.try_get(), frq::interrupted);
+  EXPECT_THROW(runque_.get_for(std::chrono::seconds{1}), frq::interrupted);
+}
+
+TEST_F(runque_multi_threaded_empty_tests, interrupt_before_put) {
+  runque_.interrupt();
+
+  EXPECT_THROW(runque_.put(1, 1), frq::interrupted);
+}
+
+TEST(runque_multi_threaded_tests, concurrent_put_get) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 10000;
+
+  frq::make_runque_t<frq::fifo_order,
+                     frq::multi_thread_model,
+                     int,
+                     std::allocator<int>>
+      runque{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      for (int j = 1; j <= item_count; ++j) {
+        runque.put(j);
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += runque.get();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+  EXPECT_FALSE(runque.try_get().has_value());
+}
+
+// runque coro
+
+class runque_coro_empty_tests : public testing::Test {
+protected:
+  void SetUp() override {
+  }
+
+  frq::runque<frq::fifo_runque_queue<test_item>, frq::coro_thread_model>
+      runque_{};
+};
+
+TEST_F(runque_coro_empty_tests, get_before_put) {
+  constexpr test_item expected{1, 1};
+
+  test_item result;
+
+  auto getter = [this, &result]() -> frq::task<> {
+    result = std::move(co_await runque_.get());
+  }();
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque_.put({1, 1}));
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_empty_tests, put_before_get) {
+  constexpr test_item expected{1, 1};
+
+  frq::sync_wait(runque_.put({1, 1}));
+  test_item const result{frq::sync_wait(runque_.get())};
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_empty_tests, get_before_emplace) {
+  constexpr test_item expected{1, 1};
+
+  test_item result;
+
+  auto getter = [this, &result]() -> frq::task<> {
+    result = std::move(co_await runque_.get());
+  }();
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque_.put(1, 1));
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_empty_tests, empalce_before_get) {
+  constexpr test_item expected{1, 1};
+
+  frq::sync_wait(runque_.put(1, 1));
+  test_item const result{frq::sync_wait(runque_.get())};
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_empty_tests, get_before_interrupt) {
+  auto getter = [this]() -> frq::task<> {
+    EXPECT_THROW(co_await runque_.get(), frq::interrupted);
+  }();
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque_.interrupt());
+}
+
+TEST_F(runque_coro_empty_tests, interrupt_before_get) {
+  frq::sync_wait(runque_.interrupt());
+  EXPECT_THROW(frq::sync_wait(runque_.get()), frq::interrupted);
+}
+
+TEST_F(runque_coro_empty_tests, interrupt_before_put) {
+  frq::sync_wait(runque_.interrupt());
+  EXPECT_THROW(frq::sync_wait(runque_.put({1, 1})), frq::interrupted);
+}
+
+TEST_F(runque_coro_empty_tests, interrupt_before_emplace) {
+  frq::sync_wait(runque_.interrupt());
+  EXPECT_THROW(frq::sync_wait(runque_.put(1, 1)), frq::interrupted);
+}
+
+// runque coro mpmc
+
+class runque_coro_mpmc_empty_tests : public testing::Test {
+protected:
+  using runque_type =
+      frq::runque<frq::mpmc_runque_queue<test_item>, frq::coro_thread_model>;
+
+  void SetUp() override {
+  }
+
+  runque_type runque_{};
+};
+
+TEST_F(runque_coro_mpmc_empty_tests, get_before_put) {
+  constexpr test_item expected{1, 1};
+
+  test_item result;
+
+  auto getter = [](runque_type& runque, test_item& result) -> frq::task<> {
+    result = std::move(co_await runque.get());
+  }(runque_, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque_.put({1, 1}));
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_mpmc_empty_tests, put_before_get) {
+  constexpr test_item expected{1, 1};
+
+  frq::sync_wait(runque_.put({1, 1}));
+  test_item const result{frq::sync_wait(runque_.get())};
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_mpmc_empty_tests, get_before_emplace) {
+  constexpr test_item expected{1, 1};
+
+  test_item result;
+
+  auto getter = [](runque_type& runque, test_item& result) -> frq::task<> {
+    result = std::move(co_await runque.get());
+  }(runque_, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque_.put(1, 1));
+
+  EXPECT_EQ(expected, result);
+}
+
+TEST_F(runque_coro_mpmc_empty_tests, get_before_interrupt) {
+  auto getter = [](runque_type& runque) -> frq::task<> {
+    EXPECT_THROW(co_await runque.get(), frq::interrupted);
+  }(runque_);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque_.interrupt());
+}
+
+TEST_F(runque_coro_mpmc_empty_tests, interrupt_before_get) {
+  frq::sync_wait(runque_.interrupt());
+  EXPECT_THROW(frq::sync_wait(runque_.get()), frq::interrupted);
+}
+
+TEST_F(runque_coro_mpmc_empty_tests, interrupt_before_put) {
+  frq::sync_wait(runque_.interrupt());
+  EXPECT_THROW(frq::sync_wait(runque_.put({1, 1})), frq::interrupted);
+}
+
+TEST(runque_coro_mpmc_tests, concurrent_put_get) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 5000;
+
+  frq::make_runque_t<frq::mpmc_fifo_order,
+                     frq::coro_thread_model,
+                     int,
+                     std::allocator<int>>
+      runque{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      for (int j = 1; j <= item_count; ++j) {
+        frq::sync_wait(runque.put(j));
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += frq::sync_wait(runque.get());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+}
+
+namespace {
+class failing_runque_queue {
+public:
+  using value_type = int;
+  using allocator_type = std::allocator<int>;
+
+  static constexpr bool is_internally_synchronized = true;
+
+  explicit inline failing_runque_queue(allocator_type const& alloc)
+      : items_{alloc} {
+  }
+
+  inline void push(value_type&& value) {
+    if (accept_ == 0) {
+      throw std::bad_alloc{};
+    }
+
+    --accept_;
+    items_.push(std::move(value));
+  }
+
+  inline value_type pop() noexcept {
+    return items_.pop();
+  }
+
+  inline std::optional<value_type> try_pop() noexcept {
+    return items_.try_pop();
+  }
+
+  inline bool empty() const noexcept {
+    return items_.empty();
+  }
+
+  std::size_t accept_{0};
+
+private:
+  frq::mpmc_runque_queue<int> items_;
+};
+} // namespace
+
+TEST(runque_coro_mpmc_tests, failed_push_is_not_counted) {
+  frq::runque<failing_runque_queue, frq::coro_thread_model> runque{};
+
+  EXPECT_THROW(frq::sync_wait(runque.put(1)), std::bad_alloc);
+  EXPECT_EQ(std::nullopt, runque.try_get());
+
+  runque.get_queue().accept_ = 1;
+
+  std::vector<int> values{2, 3};
+  EXPECT_THROW(frq::sync_wait(runque.put_many(values)), std::bad_alloc);
+  EXPECT_EQ(2, runque.try_get());
+  EXPECT_EQ(std::nullopt, runque.try_get());
+}
+
+namespace {
+using bounded_runque =
+    frq::runque<frq::mpmc_runque_queue<int, std::allocator<int>, 4>,
+                frq::coro_thread_model>;
+} // namespace
+
+TEST(runque_coro_mpmc_tests, full_queue_parks_producer) {
+  bounded_runque runque{};
+  for (int i = 0; i < 4; ++i) {
+    frq::sync_wait(runque.put(i));
+  }
+
+  bool done{false};
+  auto producer = [](bounded_runque& runque, bool& done) -> frq::task<> {
+    co_await runque.put(4);
+    done = true;
+  }(runque, done);
+
+  producer.start();
+  EXPECT_FALSE(done);
+
+  EXPECT_EQ(0, frq::sync_wait(runque.get()));
+  EXPECT_TRUE(done);
+
+  for (int i = 1; i < 5; ++i) {
+    EXPECT_EQ(i, frq::sync_wait(runque.get()));
+  }
+}
+
+TEST(runque_coro_mpmc_tests, put_many_publishes_before_parking) {
+  bounded_runque runque{};
+
+  std::vector<int> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  bool done{false};
+  auto producer = [](bounded_runque& runque,
+                     std::vector<int>& values,
+                     bool& done) -> frq::task<> {
+    co_await runque.put_many(values);
+    done = true;
+  }(runque, values, done);
+
+  producer.start();
+  EXPECT_FALSE(done);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, frq::sync_wait(runque.get()));
+  }
+
+  EXPECT_TRUE(done);
+  EXPECT_EQ(std::nullopt, runque.try_get());
+}
+
+TEST(runque_coro_mpmc_tests, interrupt_fails_parked_producer) {
+  bounded_runque runque{};
+  for (int i = 0; i < 4; ++i) {
+    frq::sync_wait(runque.put(i));
+  }
+
+  bool thrown{false};
+  auto producer = [](bounded_runque& runque, bool& thrown) -> frq::task<> {
+    try {
+      co_await runque.put(4);
+    }
+    catch (frq::interrupted const&) {
+      thrown = true;
+    }
+  }(runque, thrown);
+
+  producer.start();
+  EXPECT_FALSE(thrown);
+
+  frq::sync_wait(runque.interrupt());
+  EXPECT_TRUE(thrown);
+}
+
+TEST(runque_coro_mpmc_tests, concurrent_put_get_when_full) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 5000;
+
+  bounded_runque runque{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      for (int j = 1; j <= item_count; ++j) {
+        frq::sync_wait(runque.put(int{j}));
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += frq::sync_wait(runque.get());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+  EXPECT_EQ(std::nullopt, runque.try_get());
+}
+
+// runque coro relaxed priority
+
+TEST(runque_coro_relaxed_priority_tests, put_before_get) {
+  frq::make_runque_t<frq::relaxed_priority_order,
+                     frq::coro_thread_model,
+                     test_item,
+                     std::allocator<test_item>>
+      runque{};
+
+  frq::sync_wait(runque.put({1, 1}));
+  test_item const result{frq::sync_wait(runque.get())};
+
+  EXPECT_EQ((test_item{1, 1}), result);
+}
+
+TEST(runque_coro_relaxed_priority_tests, get_before_interrupt) {
+  using relaxed_runque = frq::make_runque_t<frq::relaxed_priority_order,
+                                            frq::coro_thread_model,
+                                            test_item,
+                                            std::allocator<test_item>>;
+
+  relaxed_runque runque{};
+
+  auto getter = [](relaxed_runque& runque) -> frq::task<> {
+    EXPECT_THROW(co_await runque.get(), frq::interrupted);
+  }(runque);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.interrupt());
+}
+
+TEST(runque_coro_relaxed_priority_tests, concurrent_put_get) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 5000;
+
+  frq::make_runque_t<frq::relaxed_priority_order,
+                     frq::coro_thread_model,
+                     int,
+                     std::allocator<int>,
+                     std::greater<>>
+      runque{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      for (int j = 1; j <= item_count; ++j) {
+        frq::sync_wait(runque.put(j));
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += frq::sync_wait(runque.get());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+}
+
+// runque coro wake policy
+
+template<typename Runque>
+std::vector<int> wake_sequence(Runque& runque, std::size_t waiters) {
+  std::vector<int> results(waiters, 0);
+  std::vector<frq::task<>> getters{};
+
+  for (std::size_t i = 0; i < waiters; ++i) {
+    getters.push_back([](Runque& runque, int& result) -> frq::task<> {
+      result = co_await runque.get();
+    }(runque, results[i]));
+
+    std::thread{[&getter = getters.back()]() { getter.start(); }}.join();
+  }
+
+  for (std::size_t i = 0; i < waiters; ++i) {
+    frq::sync_wait(runque.put(static_cast<int>(i + 1)));
+  }
+
+  return results;
+}
+
+using wake_runque =
+    frq::runque<frq::fifo_runque_queue<int>, frq::coro_thread_model>;
+
+using wake_mpmc_runque =
+    frq::runque<frq::mpmc_runque_queue<int>, frq::coro_thread_model>;
+
+TEST(runque_coro_wake_tests, lifo_by_default) {
+  wake_runque runque{};
+
+  EXPECT_EQ(frq::wake_order::lifo, runque.get_wake_order());
+  EXPECT_EQ(0, runque.get_spin_limit());
+  EXPECT_EQ((std::vector<int>{3, 2, 1}), wake_sequence(runque, 3));
+}
+
+TEST(runque_coro_wake_tests, fifo_wakes_oldest_waiter) {
+  wake_runque runque{};
+  runque.set_wake_order(frq::wake_order::fifo);
+
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), wake_sequence(runque, 3));
+}
+
+TEST(runque_coro_wake_tests, mpmc_lifo_by_default) {
+  wake_mpmc_runque runque{};
+
+  EXPECT_EQ((std::vector<int>{3, 2, 1}), wake_sequence(runque, 3));
+}
+
+TEST(runque_coro_wake_tests, mpmc_fifo_wakes_oldest_waiter) {
+  wake_mpmc_runque runque{};
+  runque.set_wake_order(frq::wake_order::fifo);
+
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), wake_sequence(runque, 3));
+}
+
+TEST(runque_coro_wake_tests, interrupt_wakes_fifo_waiters) {
+  wake_runque runque{};
+  runque.set_wake_order(frq::wake_order::fifo);
+
+  std::atomic<int> interrupted{0};
+  std::vector<frq::task<>> getters{};
+
+  for (int i = 0; i < 3; ++i) {
+    getters.push_back(
+        [](wake_runque& runque, std::atomic<int>& count) -> frq::task<> {
+          try {
+            co_await runque.get();
+          }
+          catch (frq::interrupted const&) {
+            ++count;
+          }
+        }(runque, interrupted));
+
+    std::thread{[&getter = getters.back()]() { getter.start(); }}.join();
+  }
+
+  frq::sync_wait(runque.interrupt());
+
+  EXPECT_EQ(3, interrupted.load());
+}
+
+template<typename Runque>
+long spinning_put_get(Runque& runque) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 5000;
+
+  runque.set_spin_limit(256);
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      for (int j = 1; j <= item_count; ++j) {
+        frq::sync_wait(runque.put(j));
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      for (int j = 0; j < item_count; ++j) {
+        sum += frq::sync_wait(runque.get());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(256, runque.get_spin_limit());
+  return thread_count * (item_count * (item_count + 1L) / 2) - sum;
+}
+
+TEST(runque_coro_wake_tests, spin_before_park) {
+  wake_runque runque{};
+  EXPECT_EQ(0, spinning_put_get(runque));
+}
+
+TEST(runque_coro_wake_tests, mpmc_spin_before_park) {
+  wake_mpmc_runque runque{};
+  EXPECT_EQ(0, spinning_put_get(runque));
+}
+
+// runque coro executor
+
+class deferred_executor {
+public:
+  void post(std::coroutine_handle<> handle) {
+    handles_.push_back(handle);
+  }
+
+  std::size_t run() {
+    auto handles = std::exchange(handles_, {});
+    for (auto handle : handles) {
+      handle.resume();
+    }
+
+    return handles.size();
+  }
+
+private:
+  std::vector<std::coroutine_handle<>> handles_;
+};
+
+template<typename Runque>
+void posts_woken_consumer() {
+  Runque runque{};
+  deferred_executor executor{};
+
+  int result{0};
+  auto getter = [](Runque& runque,
+                   deferred_executor& executor,
+                   int& result) -> frq::task<> {
+    result = co_await runque.get(executor);
+  }(runque, executor, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_EQ(0, result);
+
+  EXPECT_EQ(1, executor.run());
+  EXPECT_EQ(1, result);
+}
+
+TEST(runque_coro_executor_tests, posts_woken_consumer) {
+  posts_woken_consumer<wake_runque>();
+}
+
+TEST(runque_coro_executor_tests, mpmc_posts_woken_consumer) {
+  posts_woken_consumer<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_executor_tests, ready_item_skips_executor) {
+  wake_runque runque{};
+  deferred_executor executor{};
+
+  frq::sync_wait(runque.put(1));
+
+  EXPECT_EQ(1, frq::sync_wait(runque.get(executor)));
+  EXPECT_EQ(0, executor.run());
+}
+
+TEST(runque_coro_executor_tests, posts_interrupted_consumer) {
+  wake_runque runque{};
+  deferred_executor executor{};
+
+  bool interrupted{false};
+  auto getter = [](wake_runque& runque,
+                   deferred_executor& executor,
+                   bool& interrupted) -> frq::task<> {
+    try {
+      co_await runque.get(executor);
+    }
+    catch (frq::interrupted const&) {
+      interrupted = true;
+    }
+  }(runque, executor, interrupted);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.interrupt());
+  EXPECT_FALSE(interrupted);
+
+  EXPECT_EQ(1, executor.run());
+  EXPECT_TRUE(interrupted);
+}
+
+TEST(runque_coro_executor_tests, inline_executor_resumes_in_put) {
+  wake_runque runque{};
+  frq::inline_executor executor{};
+
+  int result{0};
+  auto getter = [](wake_runque& runque,
+                   frq::inline_executor& executor,
+                   int& result) -> frq::task<> {
+    result = co_await runque.get(executor);
+  }(runque, executor, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_EQ(1, result);
+}
+
+// runque put many
+
+TEST(runque_put_many_tests, single_threaded_keeps_order) {
+  frq::runque<frq::fifo_runque_queue<int>, frq::single_thread_model> runque{};
+
+  std::vector<int> values{1, 2, 3};
+  runque.put_many(values);
+
+  EXPECT_EQ(1, runque.get());
+  EXPECT_EQ(2, runque.get());
+  EXPECT_EQ(3, runque.get());
+  EXPECT_FALSE(runque.get().has_value());
+}
+
+TEST(runque_put_many_tests, multi_threaded_wakes_sleepers) {
+  frq::runque<frq::fifo_runque_queue<int>, frq::multi_thread_model> runque{};
+
+  std::atomic<int> sum{0};
+  std::vector<std::thread> getters{};
+  for (int i = 0; i < 3; ++i) {
+    getters.emplace_back([&runque, &sum] { sum += runque.get(); });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+  std::vector<int> values{1, 2, 3, 4};
+  runque.put_many(values);
+
+  for (auto& getter : getters) {
+    getter.join();
+  }
+
+  EXPECT_EQ(10, sum + runque.get());
+}
+
+template<typename Runque>
+void wakes_waiters_then_queues() {
+  Runque runque{};
+  runque.set_wake_order(frq::wake_order::fifo);
+
+  std::vector<int> results(2, 0);
+  std::vector<frq::task<>> getters{};
+
+  for (auto& result : results) {
+    getters.push_back([](Runque& runque, int& result) -> frq::task<> {
+      result = co_await runque.get();
+    }(runque, result));
+
+    std::thread{[&getter = getters.back()]() { getter.start(); }}.join();
+  }
+
+  std::vector<int> values{1, 2, 3, 4};
+  frq::sync_wait(runque.put_many(values));
+
+  EXPECT_EQ((std::vector<int>{1, 2}), results);
+  EXPECT_EQ(3, frq::sync_wait(runque.get()));
+  EXPECT_EQ(4, frq::sync_wait(runque.get()));
+}
+
+TEST(runque_put_many_tests, coro_wakes_waiters_then_queues) {
+  wakes_waiters_then_queues<wake_runque>();
+}
+
+TEST(runque_put_many_tests, mpmc_wakes_waiters_then_queues) {
+  wakes_waiters_then_queues<wake_mpmc_runque>();
+}
+
+TEST(runque_put_many_tests, interrupted) {
+  wake_runque runque{};
+  frq::sync_wait(runque.interrupt());
+
+  std::vector<int> values{1, 2};
+  EXPECT_THROW(frq::sync_wait(runque.put_many(values)), frq::interrupted);
+}
+
+template<typename Runque>
+long concurrent_put_many(Runque& runque) {
+  constexpr int thread_count = 4;
+  constexpr int batch_count = 500;
+  constexpr int batch_size = 10;
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      std::vector<int> values(batch_size);
+      for (int j = 0; j < batch_count; ++j) {
+        for (int k = 0; k < batch_size; ++k) {
+          values[k] = j * batch_size + k + 1;
+        }
+
+        frq::sync_wait(runque.put_many(values));
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      for (int j = 0; j < batch_count * batch_size; ++j) {
+        sum += frq::sync_wait(runque.get());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  constexpr long items = batch_count * batch_size;
+  return thread_count * (items * (items + 1) / 2) - sum;
+}
+
+TEST(runque_put_many_tests, coro_concurrent) {
+  wake_runque runque{};
+  EXPECT_EQ(0, concurrent_put_many(runque));
+}
+
+TEST(runque_put_many_tests, mpmc_concurrent) {
+  wake_mpmc_runque runque{};
+  EXPECT_EQ(0, concurrent_put_many(runque));
+}
+
+// runque coro try get
+
+template<typename Runque>
+void try_get_does_not_wait() {
+  Runque runque{};
+
+  EXPECT_FALSE(runque.try_get().has_value());
+
+  frq::sync_wait(runque.put(1));
+  frq::sync_wait(runque.put(2));
+
+  EXPECT_EQ(1, runque.try_get());
+  EXPECT_EQ(2, runque.try_get());
+  EXPECT_FALSE(runque.try_get().has_value());
+
+  frq::sync_wait(runque.interrupt());
+  EXPECT_THROW(runque.try_get(), frq::interrupted);
+}
+
+TEST(runque_coro_try_get_tests, does_not_wait) {
+  try_get_does_not_wait<wake_runque>();
+}
+
+TEST(runque_coro_try_get_tests, mpmc_does_not_wait) {
+  try_get_does_not_wait<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_try_get_tests, leaves_parked_waiters) {
+  wake_runque runque{};
+
+  int result{0};
+  auto getter = [](wake_runque& runque, int& result) -> frq::task<> {
+    result = co_await runque.get();
+  }(runque, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  EXPECT_FALSE(runque.try_get().has_value());
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_EQ(1, result);
+}
+
+// runque coro timed get
+
+template<typename Runque>
+frq::task<> timed_get(Runque& runque,
+                      frq::timer_wheel& timers,
+                      frq::timer_wheel::time_point deadline,
+                      std::optional<int>& result,
+                      bool& done) {
+  result = co_await runque.get_until(deadline, timers);
+  done = true;
+}
+
+template<typename Runque>
+void get_until_expires() {
+  using namespace std::chrono_literals;
+
+  // the manual wheel runs ahead of the real clock, so a late thread still
+  // parks instead of finding its deadline already passed
+  auto start = frq::timer_wheel::clock_type::now() + 1h;
+  frq::timer_wheel timers{1ms, start};
+
+  Runque runque{};
+
+  std::optional<int> result{};
+  bool done{false};
+
+  auto getter = timed_get(runque, timers, start + 5ms, result, done);
+  getter.start();
+
+  timers.advance(start + 4ms);
+  EXPECT_FALSE(done);
+
+  timers.advance(start + 5ms);
+  EXPECT_TRUE(done);
+  EXPECT_FALSE(result.has_value());
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_EQ(1, frq::sync_wait(runque.get()));
+}
+
+template<typename Runque>
+void get_until_before_put() {
+  using namespace std::chrono_literals;
+
+  auto start = frq::timer_wheel::clock_type::now();
+  frq::timer_wheel timers{1ms, start};
+
+  Runque runque{};
+
+  std::optional<int> result{};
+  bool done{false};
+
+  auto getter = timed_get(runque, timers, start + 1h, result, done);
+  getter.start();
+
+  frq::sync_wait(runque.put(1));
+  ASSERT_TRUE(done);
+  EXPECT_EQ(1, result);
+  EXPECT_TRUE(timers.empty());
+
+  EXPECT_EQ(0, timers.advance(start + 10ms));
+}
+
+template<typename Runque>
+void get_until_unlinks_expired_waiter() {
+  using namespace std::chrono_literals;
+
+  auto start = frq::timer_wheel::clock_type::now() + 1h;
+  frq::timer_wheel timers{1ms, start};
+
+  Runque runque{};
+  runque.set_wake_order(frq::wake_order::fifo);
+
+  std::vector<std::optional<int>> results(3);
+  std::vector<char> done(3, 0);
+  std::vector<frq::task<>> getters{};
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    getters.push_back(
+        [](Runque& runque,
+           frq::timer_wheel& timers,
+           frq::timer_wheel::time_point deadline,
+           std::optional<int>& result,
+           char& done) -> frq::task<> {
+          result = co_await runque.get_until(deadline, timers);
+          done = 1;
+        }(runque,
+          timers,
+          start + (i == 1 ? 5ms : 1h),
+          results[i],
+          done[i]));
+
+    getters.back().start();
+  }
+
+  timers.advance(start + 5ms);
+  EXPECT_EQ((std::vector<char>{0, 1, 0}), done);
+
+  frq::sync_wait(runque.put(1));
+  frq::sync_wait(runque.put(2));
+
+  EXPECT_EQ((std::vector<std::optional<int>>{1, std::nullopt, 2}), results);
+  EXPECT_TRUE(timers.empty());
+}
+
+template<typename Runque>
+void get_until_interrupted() {
+  using namespace std::chrono_literals;
+
+  auto start = frq::timer_wheel::clock_type::now();
+  frq::timer_wheel timers{1ms, start};
+
+  Runque runque{};
+
+  bool thrown{false};
+  auto getter = [](Runque& runque,
+                   frq::timer_wheel& timers,
+                   frq::timer_wheel::time_point deadline,
+                   bool& thrown) -> frq::task<> {
+    try {
+      co_await runque.get_until(deadline, timers);
+    }
+    catch (frq::interrupted const&) {
+      thrown = true;
+    }
+  }(runque, timers, start + 1h, thrown);
+
+  getter.start();
+  frq::sync_wait(runque.interrupt());
+
+  EXPECT_TRUE(thrown);
+  EXPECT_TRUE(timers.empty());
+}
+
+template<typename Runque>
+void get_until_posts_expiry() {
+  using namespace std::chrono_literals;
+
+  deferred_executor executor{};
+
+  auto start = frq::timer_wheel::clock_type::now() + 1h;
+  frq::timer_wheel timers{1ms, start, executor};
+
+  Runque runque{};
+
+  std::optional<int> result{};
+  bool done{false};
+
+  auto getter = timed_get(runque, timers, start + 5ms, result, done);
+  getter.start();
+
+  EXPECT_EQ(1, timers.advance(start + 5ms));
+  EXPECT_FALSE(done);
+
+  EXPECT_EQ(1, executor.run());
+  EXPECT_TRUE(done);
+  EXPECT_FALSE(result.has_value());
+}
+
+TEST(runque_coro_timed_get_tests, expires) {
+  get_until_expires<wake_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, mpmc_expires) {
+  get_until_expires<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, put_cancels_timer) {
+  get_until_before_put<wake_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, mpmc_put_cancels_timer) {
+  get_until_before_put<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, unlinks_expired_waiter) {
+  get_until_unlinks_expired_waiter<wake_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, mpmc_unlinks_expired_waiter) {
+  get_until_unlinks_expired_waiter<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, interrupt_cancels_timer) {
+  get_until_interrupted<wake_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, mpmc_interrupt_cancels_timer) {
+  get_until_interrupted<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, expiry_runs_on_wheel_executor) {
+  get_until_posts_expiry<wake_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, mpmc_expiry_runs_on_wheel_executor) {
+  get_until_posts_expiry<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_timed_get_tests, get_for_default_timers) {
+  wake_runque runque{};
+
+  auto result =
+      frq::sync_wait(runque.get_for(std::chrono::milliseconds{5}));
+  EXPECT_FALSE(result.has_value());
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_EQ(1, frq::sync_wait(runque.get_for(std::chrono::seconds{1})));
+}
+
+TEST(runque_coro_timed_get_tests, concurrent_expiry_and_put) {
+  using namespace std::chrono_literals;
+
+  constexpr int item_count = 2000;
+
+  wake_mpmc_runque runque{};
+
+  std::atomic<int> received{0};
+  std::thread consumer{[&runque, &received] {
+    for (int i = 0; i < item_count * 4 && received.load() < item_count; ++i) {
+      if (frq::sync_wait(runque.get_for(1ms)).has_value()) {
+        ++received;
+      }
+    }
+  }};
+
+  for (int i = 0; i < item_count; ++i) {
+    frq::sync_wait(runque.put(i));
+    if (i % 64 == 0) {
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+
+  consumer.join();
+
+  int left{0};
+  while (runque.try_get()) {
+    ++left;
+  }
+
+  EXPECT_EQ(item_count, received.load() + left);
+}
+
+// runque coro cancellation
+
+template<typename Runque>
+void stop_detaches_single_waiter() {
+  Runque runque{};
+  runque.set_wake_order(frq::wake_order::fifo);
+
+  std::vector<std::stop_source> sources(3);
+  std::vector<int> results(3, 0);
+  std::vector<char> cancelled(3, 0);
+  std::vector<frq::task<>> getters{};
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    getters.push_back([](Runque& runque,
+                         std::stop_token stop,
+                         int& result,
+                         char& cancelled) -> frq::task<> {
+      try {
+        result = co_await runque.get(std::move(stop));
+      }
+      catch (frq::cancelled const&) {
+        cancelled = 1;
+      }
+    }(runque, sources[i].get_token(), results[i], cancelled[i]));
+
+    std::thread{[&getter = getters.back()]() { getter.start(); }}.join();
+  }
+
+  sources[1].request_stop();
+  EXPECT_EQ((std::vector<char>{0, 1, 0}), cancelled);
+
+  frq::sync_wait(runque.put(1));
+  frq::sync_wait(runque.put(2));
+
+  EXPECT_EQ((std::vector<int>{1, 0, 2}), results);
+}
+
+template<typename Runque>
+void stop_before_get() {
+  Runque runque{};
+
+  std::stop_source source{};
+  source.request_stop();
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_THROW(frq::sync_wait(runque.get(source.get_token())),
+               frq::cancelled);
+
+  EXPECT_EQ(1, frq::sync_wait(runque.get()));
+}
+
+template<typename Runque>
+void stop_after_put() {
+  Runque runque{};
+
+  std::stop_source source{};
+
+  int result{0};
+  auto getter = [](Runque& runque,
+                   std::stop_token stop,
+                   int& result) -> frq::task<> {
+    result = co_await runque.get(std::move(stop));
+  }(runque, source.get_token(), result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.put(1));
+  source.request_stop();
+
+  EXPECT_EQ(1, result);
+}
+
+template<typename Runque>
+void cancel_while_putting() {
+  constexpr int consumer_count = 4;
+  constexpr int item_count = 2000;
+
+  Runque runque{};
+
+  std::atomic<int> received{0};
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> consumers{};
+  for (int i = 0; i < consumer_count; ++i) {
+    consumers.emplace_back([&runque, &received, &done] {
+      while (!done.load()) {
+        std::stop_source source{};
+        std::thread stopper{[&source] {
+          std::this_thread::yield();
+          source.request_stop();
+        }};
+
+        try {
+          frq::sync_wait(runque.get(source.get_token()));
+          ++received;
+        }
+        catch (frq::cancelled const&) {
+        }
+
+        stopper.join();
+      }
+    });
+  }
+
+  for (int i = 0; i < item_count; ++i) {
+    frq::sync_wait(runque.put(i));
+  }
+
+  while (received.load() < item_count) {
+    std::this_thread::yield();
+    if (runque.try_get()) {
+      ++received;
+    }
+  }
+
+  done = true;
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+
+  EXPECT_EQ(item_count, received.load());
+  EXPECT_FALSE(runque.try_get().has_value());
+}
+
+template<typename Runque>
+void stop_posts_to_waiter_executor() {
+  Runque runque{};
+  deferred_executor executor{};
+
+  std::stop_source source{};
+  bool cancelled{false};
+
+  auto getter = [](Runque& runque,
+                   std::stop_token stop,
+                   deferred_executor& executor,
+                   bool& cancelled) -> frq::task<> {
+    try {
+      co_await runque.get(std::move(stop), executor);
+    }
+    catch (frq::cancelled const&) {
+      cancelled = true;
+    }
+  }(runque, source.get_token(), executor, cancelled);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  source.request_stop();
+  EXPECT_FALSE(cancelled);
+
+  while (executor.run() != 0) {
+  }
+
+  EXPECT_TRUE(cancelled);
+
+  frq::sync_wait(runque.put(1));
+  EXPECT_EQ(1, frq::sync_wait(runque.get()));
+}
+
+TEST(runque_coro_cancel_tests, detaches_single_waiter) {
+  stop_detaches_single_waiter<wake_runque>();
+}
+
+TEST(runque_coro_cancel_tests, mpmc_detaches_single_waiter) {
+  stop_detaches_single_waiter<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_cancel_tests, stop_before_get) {
+  stop_before_get<wake_runque>();
+}
+
+TEST(runque_coro_cancel_tests, mpmc_stop_before_get) {
+  stop_before_get<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_cancel_tests, stop_after_put) {
+  stop_after_put<wake_runque>();
+}
+
+TEST(runque_coro_cancel_tests, mpmc_stop_after_put) {
+  stop_after_put<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_cancel_tests, concurrent_cancel_and_put) {
+  cancel_while_putting<wake_runque>();
+}
+
+TEST(runque_coro_cancel_tests, stop_posts_to_waiter_executor) {
+  stop_posts_to_waiter_executor<wake_runque>();
+}
+
+TEST(runque_coro_cancel_tests, mpmc_stop_posts_to_waiter_executor) {
+  stop_posts_to_waiter_executor<wake_mpmc_runque>();
+}
+
+TEST(runque_coro_cancel_tests, mpmc_concurrent_cancel_and_put) {
+  cancel_while_putting<wake_mpmc_runque>();
 }
 
 // NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
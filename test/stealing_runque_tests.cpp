@@ -0,0 +1,179 @@
+
+#include "forque.hpp"
+#include "stealing_runque.hpp"
+#include "sync_wait.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
+
+using int_runque = frq::stealing_runque<int, std::allocator<int>, 8, 4>;
+
+static_assert(frq::runlike<int_runque>);
+
+TEST(stealing_runque_tests, put_before_get) {
+  int_runque runque{};
+
+  frq::sync_wait(runque.put(1));
+
+  EXPECT_EQ(1, frq::sync_wait(runque.get()));
+}
+
+TEST(stealing_runque_tests, get_before_put) {
+  int_runque runque{};
+
+  int result{0};
+  auto getter = [](int_runque& runque, int& result) -> frq::task<> {
+    result = co_await runque.get();
+  }(runque, result);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.put(1));
+
+  EXPECT_EQ(1, result);
+}
+
+TEST(stealing_runque_tests, local_is_lifo) {
+  int_runque runque{};
+  auto scope = runque.attach();
+
+  ASSERT_TRUE(scope.attached());
+
+  frq::sync_wait(runque.put(1));
+  frq::sync_wait(runque.put(2));
+
+  EXPECT_EQ(2, frq::sync_wait(runque.get()));
+  EXPECT_EQ(1, frq::sync_wait(runque.get()));
+}
+
+TEST(stealing_runque_tests, local_overflow_goes_to_injection) {
+  int_runque runque{};
+  auto scope = runque.attach();
+
+  for (int i = 0; i < 6; ++i) {
+    frq::sync_wait(runque.put(i));
+  }
+
+  std::vector<int> result{};
+  for (int i = 0; i < 6; ++i) {
+    result.push_back(frq::sync_wait(runque.get()));
+  }
+
+  EXPECT_EQ((std::vector<int>{3, 2, 1, 0, 4, 5}), result);
+}
+
+TEST(stealing_runque_tests, idle_worker_steals_oldest) {
+  int_runque runque{};
+  auto scope = runque.attach();
+
+  frq::sync_wait(runque.put(1));
+  frq::sync_wait(runque.put(2));
+
+  int result{0};
+  std::thread{[&runque, &result]() {
+    auto scope = runque.attach();
+    result = frq::sync_wait(runque.get());
+  }}.join();
+
+  EXPECT_EQ(1, result);
+}
+
+TEST(stealing_runque_tests, attach_exhausted) {
+  int_runque runque{};
+
+  std::vector<int_runque::worker_scope> scopes{};
+  for (int i = 0; i < 8; ++i) {
+    scopes.push_back(runque.attach());
+    EXPECT_TRUE(scopes.back().attached());
+  }
+
+  EXPECT_FALSE(runque.attach().attached());
+
+  scopes.pop_back();
+  EXPECT_TRUE(runque.attach().attached());
+}
+
+TEST(stealing_runque_tests, interrupt_wakes_waiter) {
+  int_runque runque{};
+
+  auto getter = [](int_runque& runque) -> frq::task<> {
+    EXPECT_THROW(co_await runque.get(), frq::interrupted);
+  }(runque);
+
+  std::thread{[&getter]() { getter.start(); }}.join();
+
+  frq::sync_wait(runque.interrupt());
+  EXPECT_THROW(frq::sync_wait(runque.put(1)), frq::interrupted);
+}
+
+TEST(stealing_runque_tests, concurrent_workers) {
+  constexpr int thread_count = 4;
+  constexpr int item_count = 5000;
+
+  int_runque runque{};
+
+  std::atomic<long> sum{0};
+  std::vector<std::thread> threads{};
+
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back([&runque] {
+      for (int j = 1; j <= item_count; ++j) {
+        frq::sync_wait(runque.put(j));
+      }
+    });
+
+    threads.emplace_back([&runque, &sum] {
+      auto scope = runque.attach();
+      for (int j = 0; j < item_count; ++j) {
+        auto value = frq::sync_wait(runque.get());
+        if (value > 0 && j % 2 == 0) {
+          frq::sync_wait(runque.put(-value));
+          --j;
+        }
+        else {
+          sum += value > 0 ? value : -value;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(thread_count * (item_count * (item_count + 1L) / 2), sum);
+}
+
+using retainment_type = frq::retainment<int>;
+using stealing_queue =
+    frq::forque<int,
+                frq::stealing_runque<retainment_type,
+                                     std::allocator<retainment_type>>,
+                frq::stag_t<int, int>>;
+
+TEST(stealing_runque_tests, serves_forque) {
+  stealing_queue queue{};
+  auto scope = queue.get_runque().attach();
+
+  frq::stag_t<int, int> const tag{frq::construct_tag_default, 1, 2};
+
+  frq::sync_wait(queue.reserve(tag, 1));
+  frq::sync_wait(queue.reserve(tag, 2));
+
+  auto first = frq::sync_wait(queue.get());
+  EXPECT_EQ(1, first.value());
+
+  frq::sync_wait(first.finalize());
+
+  auto second = frq::sync_wait(queue.get());
+  EXPECT_EQ(2, second.value());
+
+  frq::sync_wait(second.finalize());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-capturing-lambda-coroutines,cppcoreguidelines-avoid-reference-coroutine-parameters)
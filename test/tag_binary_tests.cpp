@@ -0,0 +1,176 @@
+
+#include "tag_binary.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+template<typename Tag>
+std::vector<char> encode(Tag const& tag) {
+  std::array<char, 128> buffer{};
+
+  auto [ptr, ec] =
+      frq::tag_to_bytes(buffer.data(), buffer.data() + buffer.size(), tag);
+  EXPECT_EQ(std::errc{}, ec);
+
+  return std::vector<char>{buffer.data(), ptr};
+}
+
+template<typename Tag>
+std::from_chars_result decode(std::vector<char> const& bytes, Tag& tag) {
+  return frq::tag_from_bytes(bytes.data(), bytes.data() + bytes.size(), tag);
+}
+} // namespace
+
+using binary_stag = frq::
+    stag_t<std::int32_t, std::string, double, frq::interval<std::uint16_t>>;
+
+TEST(tag_binary_tests, encode_layout) {
+  frq::stag_t<std::int32_t, std::string> const tag{
+      frq::construct_tag_default, -2, "ab"};
+
+  EXPECT_EQ((std::vector<char>{2, 3, 3, 0xb, 2, 'a', 'b'}), encode(tag));
+}
+
+TEST(tag_binary_tests, round_trip_stag) {
+  binary_stag const tag{frq::construct_tag_default,
+                        -123456,
+                        "abc",
+                        2.5,
+                        frq::interval<std::uint16_t>{3, 700}};
+
+  binary_stag result{
+      frq::construct_tag_default, 0, "", 0.0, frq::interval<std::uint16_t>{}};
+
+  auto bytes = encode(tag);
+  auto [ptr, ec] = decode(bytes, result);
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ(bytes.data() + bytes.size(), ptr);
+  EXPECT_EQ(tag.values(), result.values());
+}
+
+TEST(tag_binary_tests, round_trip_dtag) {
+  frq::dtag<> const tag{frq::construct_tag_default,
+                        std::uint64_t{1} << 40U,
+                        std::string{"x"},
+                        frq::wildcard,
+                        frq::interval<std::int8_t>{-1, 1},
+                        1.5F};
+
+  frq::dtag<> result{frq::construct_tag_default};
+
+  auto bytes = encode(tag);
+  auto [ptr, ec] = decode(bytes, result);
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ(bytes.data() + bytes.size(), ptr);
+  EXPECT_EQ(tag.values(), result.values());
+  EXPECT_TRUE(result.values()[2].wildcard());
+}
+
+TEST(tag_binary_tests, decode_dtag_with_allocator) {
+  frq::dtag<> const tag{
+      frq::construct_tag_default, std::int32_t{7}, std::string{"y"}};
+  frq::dtag<> result{frq::construct_tag_default};
+
+  auto bytes = encode(tag);
+  auto [ptr, ec] = frq::tag_from_bytes(bytes.data(),
+                                       bytes.data() + bytes.size(),
+                                       result,
+                                       frq::dtag<>::allocator_type{});
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ(tag.values(), result.values());
+}
+
+TEST(tag_binary_tests, encode_too_large) {
+  frq::stag_t<std::string> const tag{frq::construct_tag_default, "abcdef"};
+
+  std::array<char, 4> buffer{};
+  auto [ptr, ec] =
+      frq::tag_to_bytes(buffer.data(), buffer.data() + buffer.size(), tag);
+
+  EXPECT_EQ(std::errc::value_too_large, ec);
+}
+
+TEST(tag_binary_tests, decode_truncated) {
+  binary_stag const tag{frq::construct_tag_default,
+                        7,
+                        "abc",
+                        0.5,
+                        frq::interval<std::uint16_t>{1, 2}};
+
+  auto bytes = encode(tag);
+  for (auto size = bytes.size(); size-- != 0;) {
+    std::vector<char> prefix{bytes.begin(), bytes.begin() + size};
+
+    binary_stag stag_result{frq::construct_tag_default,
+                            0,
+                            "",
+                            0.0,
+                            frq::interval<std::uint16_t>{}};
+    EXPECT_NE(std::errc{}, decode(prefix, stag_result).ec);
+
+    frq::dtag<> dtag_result{frq::construct_tag_default};
+    EXPECT_NE(std::errc{}, decode(prefix, dtag_result).ec);
+    EXPECT_EQ(0, dtag_result.size());
+  }
+}
+
+TEST(tag_binary_tests, decode_type_mismatch) {
+  frq::stag_t<std::int32_t> const tag{frq::construct_tag_default, 1};
+
+  frq::stag_t<std::uint32_t> result{frq::construct_tag_default, 0U};
+  auto bytes = encode(tag);
+
+  EXPECT_EQ(std::errc::invalid_argument, decode(bytes, result).ec);
+  EXPECT_EQ(0U, std::get<0>(result.values()));
+}
+
+TEST(tag_binary_tests, decode_out_of_range) {
+  frq::stag_t<std::int8_t> result{frq::construct_tag_default, 0};
+
+  std::vector<char> const bytes{1, 1, static_cast<char>(0x80), 2};
+
+  EXPECT_EQ(std::errc::result_out_of_range, decode(bytes, result).ec);
+}
+
+TEST(tag_binary_tests, fingerprint_stag_dtag) {
+  frq::stag_t<std::int32_t, std::string> const stag{
+      frq::construct_tag_default, 5, "abc"};
+  frq::dtag<> const dtag{
+      frq::construct_tag_default, std::int32_t{5}, std::string{"abc"}};
+
+  EXPECT_EQ(frq::tag_fingerprint(stag), frq::tag_fingerprint(dtag));
+  EXPECT_EQ(frq::tag_fingerprint(stag, 1), frq::tag_fingerprint(dtag, 1));
+}
+
+TEST(tag_binary_tests, fingerprint_prefix) {
+  frq::stag_t<std::int32_t, std::int32_t> const tag{
+      frq::construct_tag_default, 1, 2};
+  frq::stag_t<std::int32_t> const parent{frq::construct_tag_default, 1};
+
+  EXPECT_EQ(frq::tag_fingerprint(parent), frq::tag_fingerprint(tag, 1));
+  EXPECT_NE(frq::tag_fingerprint(tag, 1), frq::tag_fingerprint(tag));
+  EXPECT_NE(frq::tag_fingerprint(tag, 0), frq::tag_fingerprint(tag, 1));
+}
+
+TEST(tag_binary_tests, fingerprint_type_sensitive) {
+  frq::dtag<> const signed_tag{frq::construct_tag_default, std::int32_t{1}};
+  frq::dtag<> const unsigned_tag{frq::construct_tag_default, std::uint32_t{1}};
+
+  EXPECT_NE(frq::tag_fingerprint(signed_tag),
+            frq::tag_fingerprint(unsigned_tag));
+}
+
+TEST(tag_binary_tests, fingerprint_signed_zero) {
+  frq::stag_t<double> const positive{frq::construct_tag_default, 0.0};
+  frq::stag_t<double> const negative{frq::construct_tag_default, -0.0};
+
+  EXPECT_EQ(frq::tag_fingerprint(positive), frq::tag_fingerprint(negative));
+}
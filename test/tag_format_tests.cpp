@@ -0,0 +1,172 @@
+
+#include "tag_format.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace {
+template<typename Tag>
+std::string format(Tag const& tag) {
+  std::array<char, 64> buffer{};
+
+  auto [ptr, ec] =
+      frq::tag_to_chars(buffer.data(), buffer.data() + buffer.size(), tag);
+  EXPECT_EQ(std::errc{}, ec);
+
+  return std::string{buffer.data(), ptr};
+}
+
+template<typename Tag>
+std::from_chars_result parse(std::string_view text, Tag& tag) {
+  return frq::tag_from_chars(text.data(), text.data() + text.size(), tag);
+}
+
+template<typename Schema, typename Tag>
+std::from_chars_result
+    parse(Schema const& schema, std::string_view text, Tag& tag) {
+  return schema.parse(text.data(), text.data() + text.size(), tag);
+}
+} // namespace
+
+using text_stag = frq::stag_t<int, std::string, frq::interval<int>>;
+
+TEST(tag_format_tests, format_stag) {
+  text_stag const tag{
+      frq::construct_tag_default, 1, "x", frq::interval<int>{2, 5}};
+
+  EXPECT_EQ("/1/x/[2,5)", format(tag));
+}
+
+TEST(tag_format_tests, format_sub_stag) {
+  frq::sub_tag_t<text_stag, 2> const tag{frq::construct_tag_default, 7, "y"};
+
+  EXPECT_EQ("/7/y", format(tag));
+}
+
+TEST(tag_format_tests, format_dtag) {
+  frq::dtag<> const tag{
+      frq::construct_tag_default, 1, 2.5, frq::wildcard, std::string{"x"}};
+
+  EXPECT_EQ("/1/2.5/*/x", format(tag));
+}
+
+TEST(tag_format_tests, format_too_large) {
+  frq::stag_t<int, int> const tag{frq::construct_tag_default, 12, 34};
+
+  std::array<char, 5> buffer{};
+  auto [ptr, ec] =
+      frq::tag_to_chars(buffer.data(), buffer.data() + buffer.size(), tag);
+
+  EXPECT_EQ(std::errc::value_too_large, ec);
+}
+
+TEST(tag_format_tests, parse_stag) {
+  text_stag tag{frq::construct_tag_default, 0, "", frq::interval<int>{0, 0}};
+
+  auto text = std::string_view{"/1/x/[2,5)"};
+  auto [ptr, ec] = parse(text, tag);
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ(text.data() + text.size(), ptr);
+  EXPECT_EQ((std::tuple{1, std::string{"x"}, frq::interval<int>{2, 5}}),
+            tag.values());
+}
+
+TEST(tag_format_tests, parse_stag_invalid_value) {
+  frq::stag_t<int, int> tag{frq::construct_tag_default, 0, 0};
+
+  auto text = std::string_view{"/1/2x"};
+  auto [ptr, ec] = parse(text, tag);
+
+  EXPECT_EQ(std::errc::invalid_argument, ec);
+  EXPECT_EQ(text.data() + 4, ptr);
+  EXPECT_EQ((std::tuple{0, 0}), tag.values());
+}
+
+TEST(tag_format_tests, parse_stag_wrong_depth) {
+  frq::stag_t<int, int> tag{frq::construct_tag_default, 0, 0};
+
+  EXPECT_EQ(std::errc::invalid_argument, parse("/1", tag).ec);
+  EXPECT_EQ(std::errc::invalid_argument, parse("/1/2/3", tag).ec);
+  EXPECT_EQ(std::errc::invalid_argument, parse("1/2", tag).ec);
+}
+
+TEST(tag_format_tests, parse_dtag) {
+  frq::dtag_schema<int, std::string, double> const schema{};
+  frq::dtag<> tag{frq::construct_tag_default};
+
+  auto [ptr, ec] = parse(schema, "/1/*/2.5", tag);
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ(
+      (frq::dtag<>{frq::construct_tag_default, 1, frq::wildcard, 2.5}.values()),
+      tag.values());
+  EXPECT_TRUE(tag.values()[1].wildcard());
+}
+
+TEST(tag_format_tests, parse_dtag_prefix) {
+  frq::dtag_schema<int, std::string, double> const schema{};
+  frq::dtag<> tag{frq::construct_tag_default};
+
+  auto [ptr, ec] = parse(schema, "/1/x", tag);
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ((frq::dtag<>{frq::construct_tag_default, 1, std::string{"x"}}
+                 .values()),
+            tag.values());
+}
+
+TEST(tag_format_tests, parse_dtag_too_deep) {
+  frq::dtag_schema<int> const schema{};
+  frq::dtag<> tag{frq::construct_tag_default};
+
+  EXPECT_EQ(std::errc::invalid_argument, parse(schema, "/1/2", tag).ec);
+  EXPECT_EQ(std::errc::invalid_argument, parse(schema, "", tag).ec);
+  EXPECT_EQ(0, tag.size());
+}
+
+TEST(tag_format_tests, round_trip) {
+  frq::dtag_schema<int, std::string, frq::interval<int>> const schema{};
+  frq::dtag<> tag{frq::construct_tag_default};
+
+  auto [ptr, ec] = parse(schema, "/10/abc/[-3,7)", tag);
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_EQ("/10/abc/[-3,7)", format(tag));
+}
+
+TEST(tag_format_tests, format_rejects_ambiguous_strings) {
+  std::array<char, 64> buffer{};
+  auto format_error = [&buffer](auto const& tag) {
+    return frq::tag_to_chars(buffer.data(), buffer.data() + buffer.size(), tag)
+        .ec;
+  };
+
+  EXPECT_EQ(std::errc::invalid_argument,
+            format_error(frq::stag_t<int, std::string>{
+                frq::construct_tag_default, 1, "a/b"}));
+  EXPECT_EQ(std::errc::invalid_argument,
+            format_error(frq::dtag<>{
+                frq::construct_tag_default, 1, std::string{"*"}}));
+  EXPECT_EQ(std::errc{},
+            format_error(frq::dtag<>{
+                frq::construct_tag_default, 1, std::string{"a*"}}));
+}
+
+TEST(tag_format_tests, round_trip_with_allocator) {
+  frq::dtag_schema<int, std::string> const schema{};
+  frq::dtag<> tag{frq::construct_tag_default};
+
+  auto text = std::string_view{"/1/a*b"};
+  auto [ptr, ec] = schema.parse(text.data(),
+                                text.data() + text.size(),
+                                tag,
+                                frq::dtag<>::allocator_type{});
+
+  EXPECT_EQ(std::errc{}, ec);
+  EXPECT_FALSE(tag.values()[1].wildcard());
+  EXPECT_EQ(text, format(tag));
+}
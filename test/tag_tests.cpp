@@ -449,6 +449,16 @@ TEST(stag_stream_tests, format) {
   EXPECT_EQ("/1/2", stream.str());
 }
 
+TEST(stag_stream_tests, format_interval) {
+  frq::stag<2, int, frq::interval<int>> const tag{
+      frq::construct_tag_default, 1, frq::interval<int>{2, 5}};
+
+  std::stringstream stream;
+  stream << tag;
+
+  EXPECT_EQ("/1/[2,5)", stream.str());
+}
+
 TEST(dtag_stream_tests, format) {
   frq::dtag<> const tag{frq::construct_tag_default, 1, 2};
 
@@ -457,3 +467,12 @@ TEST(dtag_stream_tests, format) {
 
   EXPECT_EQ("/1/2", stream.str());
 }
+
+TEST(dtag_stream_tests, format_wildcard) {
+  frq::dtag<> const tag{frq::construct_tag_default, 1, frq::wildcard, 2};
+
+  std::stringstream stream;
+  stream << tag;
+
+  EXPECT_EQ("/1/*/2", stream.str());
+}
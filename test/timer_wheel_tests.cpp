@@ -0,0 +1,149 @@
+
+#include "timer_wheel.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace {
+using namespace std::chrono_literals;
+
+struct fired_log {
+  std::vector<int> fired_;
+};
+
+struct log_entry {
+  inline log_entry(fired_log& log, int id) noexcept
+      : log_{&log}
+      , id_{id}
+      , entry_{&fire, this} {
+  }
+
+  static void fire(void* context) noexcept {
+    auto* self = static_cast<log_entry*>(context);
+    self->log_->fired_.push_back(self->id_);
+  }
+
+  fired_log* log_;
+  int id_;
+  frq::timer_entry entry_;
+};
+
+class timer_wheel_tests : public testing::Test {
+protected:
+  frq::timer_wheel::time_point at(std::uint64_t ticks) const {
+    return start_ + std::chrono::milliseconds{ticks};
+  }
+
+  frq::timer_wheel::time_point start_{frq::timer_wheel::clock_type::now()};
+  frq::timer_wheel timers_{1ms, start_};
+
+  fired_log log_{};
+};
+} // namespace
+
+TEST_F(timer_wheel_tests, empty_when_constructed) {
+  EXPECT_TRUE(timers_.empty());
+  EXPECT_EQ(0, timers_.advance(at(100)));
+}
+
+TEST_F(timer_wheel_tests, fires_at_deadline) {
+  log_entry entry{log_, 1};
+  timers_.schedule(entry.entry_, at(10));
+
+  EXPECT_EQ(0, timers_.advance(at(9)));
+  EXPECT_TRUE(log_.fired_.empty());
+
+  EXPECT_EQ(1, timers_.advance(at(10)));
+  EXPECT_EQ(std::vector<int>{1}, log_.fired_);
+  EXPECT_TRUE(timers_.empty());
+}
+
+TEST_F(timer_wheel_tests, rounds_deadline_up) {
+  log_entry entry{log_, 1};
+  timers_.schedule(entry.entry_, at(10) + 100us);
+
+  EXPECT_EQ(0, timers_.advance(at(10) + 500us));
+  EXPECT_EQ(1, timers_.advance(at(11)));
+}
+
+TEST_F(timer_wheel_tests, past_deadline_fires_on_next_advance) {
+  timers_.advance(at(20));
+
+  log_entry entry{log_, 1};
+  timers_.schedule(entry.entry_, at(5));
+
+  EXPECT_EQ(1, timers_.advance(at(20)));
+}
+
+TEST_F(timer_wheel_tests, fires_across_levels) {
+  std::vector<std::uint64_t> const deadlines{3, 70, 5000, 300000, 64, 4096};
+
+  std::vector<std::unique_ptr<log_entry>> entries{};
+  for (std::size_t i = 0; i < deadlines.size(); ++i) {
+    entries.push_back(
+        std::make_unique<log_entry>(log_, static_cast<int>(deadlines[i])));
+    timers_.schedule(entries.back()->entry_, at(deadlines[i]));
+  }
+
+  for (auto deadline : {3, 64, 70, 4096, 5000, 300000}) {
+    timers_.advance(at(deadline - 1));
+    EXPECT_EQ(log_.fired_.end(),
+              std::find(log_.fired_.begin(), log_.fired_.end(), deadline));
+
+    timers_.advance(at(deadline));
+    ASSERT_FALSE(log_.fired_.empty());
+    EXPECT_EQ(deadline, log_.fired_.back());
+  }
+
+  EXPECT_TRUE(timers_.empty());
+}
+
+TEST_F(timer_wheel_tests, cancel_pending) {
+  log_entry first{log_, 1};
+  log_entry second{log_, 2};
+
+  timers_.schedule(first.entry_, at(10));
+  timers_.schedule(second.entry_, at(10));
+
+  EXPECT_TRUE(timers_.cancel(first.entry_));
+
+  timers_.advance(at(10));
+  EXPECT_EQ(std::vector<int>{2}, log_.fired_);
+
+  EXPECT_FALSE(timers_.cancel(second.entry_));
+}
+
+TEST_F(timer_wheel_tests, reschedule_after_fire) {
+  log_entry entry{log_, 1};
+
+  timers_.schedule(entry.entry_, at(10));
+  timers_.advance(at(10));
+
+  timers_.schedule(entry.entry_, at(15));
+  timers_.advance(at(15));
+
+  EXPECT_EQ((std::vector<int>{1, 1}), log_.fired_);
+}
+
+TEST(timer_service_tests, fires_in_real_time) {
+  frq::timer_service service{1ms};
+
+  std::promise<void> fired{};
+  frq::timer_entry entry{
+      [](void* context) noexcept {
+        static_cast<std::promise<void>*>(context)->set_value();
+      },
+      &fired};
+
+  service.wheel().schedule(entry,
+                           frq::timer_wheel::clock_type::now() + 2ms);
+
+  EXPECT_EQ(std::future_status::ready,
+            fired.get_future().wait_for(std::chrono::seconds{5}));
+}